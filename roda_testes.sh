@@ -20,28 +20,19 @@ make
 # Executa testes
 echo "Executando testes..."
 
-# Testes pequenos e médios
-echo "Testando instâncias pequenas..."
-for i in {1..3}; do
-    ./tsp_bb instances/small_$i.txt
-    ./tsp_mip instances/small_$i.txt
-done
-
-echo "Testando instâncias médias..."
-for i in {1..3}; do
-    ./tsp_bb instances/medium_$i.txt
-    ./tsp_mip instances/medium_$i.txt
-done
-
-# Testes grandes apenas se especificado
+# Instâncias pequenas e médias; grandes apenas se especificado
+INSTANCIAS="instances/small_*.txt instances/medium_*.txt"
 if [ "$1" = "--all" ]; then
-    echo "Testando instâncias grandes..."
-    for i in {1..3}; do
-        ./tsp_bb instances/large_$i.txt
-        ./tsp_mip instances/large_$i.txt
-    done
+    INSTANCIAS="$INSTANCIAS instances/large_*.txt"
 fi
 
+# Modo lote: um processo por método, instâncias distribuídas entre os núcleos
+echo "Testando com Branch and Bound..."
+./tsp_bb --batch $INSTANCIAS
+
+echo "Testando com PLI..."
+./tsp_mip --batch $INSTANCIAS
+
 # Gera resultados
 echo "Gerando resultados..."
 python3 scripts/gera_tabelas.py
@@ -70,6 +70,31 @@ def compara_solucoes(df):
             pct = (diff / min(row['Custo_BB'], row['Custo_PLI'])) * 100
             print(f"  Diferença: {diff:.2f} ({pct:.2f}%)")
 
+def analisa_desempenho():
+    """Contadores da busca a partir da telemetria (resultados/telemetria.csv)"""
+    if not os.path.exists('resultados/telemetria.csv'):
+        return
+    tel = pd.read_csv('resultados/telemetria.csv')
+    print("\n=== Desempenho da Busca (telemetria) ===")
+    for metodo, grupo in tel.groupby('method'):
+        print(f"\n{metodo}:")
+        for _, row in grupo.iterrows():
+            linha = f"  {row['instance']}: {row['time']:.2f}s"
+            if pd.notna(row['nodes_explored']):
+                linha += f", {row['nodes_explored']:.0f} nós"
+            if pd.notna(row['nodes_per_second']):
+                linha += f" ({row['nodes_per_second']:.0f} nós/s)"
+            if pd.notna(row['peak_frontier']):
+                linha += f", pico de {row['peak_frontier']:.0f} abertos"
+            if pd.notna(row['peak_rss_kb']):
+                linha += f", {row['peak_rss_kb'] / 1024:.1f} MB"
+            print(linha)
+        fases = [c for c in grupo.columns if c.startswith('fase_') and grupo[c].notna().any()]
+        if fases:
+            print("  Tempo médio por fase:")
+            for fase in fases:
+                print(f"    {fase[len('fase_'):]}: {grupo[fase].mean():.3f}s")
+
 def gera_graficos_comparativos(df):
     """Gera gráficos comparativos"""
     if not os.path.exists('resultados'):
@@ -132,6 +157,7 @@ def main():
         analisa_limite_tempo(df)
         analisa_viabilidade(df)
         compara_solucoes(df)
+        analisa_desempenho()
         
         sys.stdout = stdout
     
@@ -1,55 +1,62 @@
+import json
 import os
+import re
 import pandas as pd
 
+# Campos de telemetria copiados para resultados/telemetria.csv
+CAMPOS_TELEMETRIA = ['instance', 'engine', 'method', 'status', 'cost', 'lower_bound', 'gap',
+                     'time', 'threads', 'nodes_explored', 'nodes_pruned', 'nodes_per_second',
+                     'peak_frontier', 'peak_rss_kb']
+
+def carrega_telemetria():
+    """Lê os registros logs/<instância>_<método>.json gravados pelos executáveis"""
+    registros = []
+    for arquivo in sorted(os.listdir('logs')):
+        if not arquivo.endswith('.json'):
+            continue
+        with open(f'logs/{arquivo}', 'r') as f:
+            try:
+                registro = json.load(f)
+            except json.JSONDecodeError as erro:
+                print(f"AVISO: {arquivo} não é um JSON válido ({erro})")
+                continue
+        registro['fases'] = {fase['name']: fase['seconds'] for fase in registro.get('phases', [])}
+        registros.append(registro)
+        print(f"Processado {arquivo}: {registro['method']} custo={registro['cost']} "
+              f"gap={registro['gap']} tempo={registro['time']}")
+    return registros
+
+def numero_instancia(nome):
+    """Número final do nome da instância (small_10 -> 10), para ordenar"""
+    m = re.search(r'(\d+)$', nome)
+    return int(m.group(1)) if m else 0
+
 def processa_logs():
-    resultados = []
-    
-    for arquivo in os.listdir('logs'):
-        if arquivo.endswith('.log'):
-            with open(f'logs/{arquivo}', 'r') as f:
-                conteudo = f.read()
-                linhas = conteudo.split('\n')
-                
-                dados = {}
-                resultados_finais = False
-                
-                for linha in linhas:
-                    if 'Instância:' in linha and not 'Resultados finais' in linha:
-                        nome_instancia = linha.split(':')[1].strip()
-                        nome_instancia = nome_instancia.replace('.txt', '')
-                        dados['Instância'] = nome_instancia
-                    elif 'Método:' in linha:
-                        # Ajuste aqui: identifica BB ou PLI diretamente do texto
-                        dados['Método'] = linha.split(':')[1].strip()
-                    elif 'Resultados finais' in linha:
-                        resultados_finais = True
-                    elif resultados_finais and 'Custo:' in linha:
-                        dados['Custo'] = float(linha.split(':')[1].strip())
-                    elif resultados_finais and 'Gap:' in linha:
-                        dados['Gap (%)'] = float(linha.split(':')[1].strip().replace('%',''))
-                    elif resultados_finais and 'Tempo:' in linha:
-                        dados['Tempo (s)'] = float(linha.split(':')[1].strip().replace('s','').strip())
-                
-                if len(dados) == 5:  # Todos os campos necessários
-                    resultados.append(dados)
-                    print(f"Processado {arquivo}: {dados}")
-                else:
-                    print(f"AVISO: Arquivo {arquivo} não contém todos os campos necessários")
-                    print(f"Campos encontrados: {dados.keys()}")
-                    print("Conteúdo do arquivo:")
-                    print("---")
-                    print(conteudo)
-                    print("---")
-    
-    if not resultados:
+    registros = carrega_telemetria()
+    if not registros:
         print("AVISO: Nenhum resultado processado!")
         return pd.DataFrame()
-        
-    df = pd.DataFrame(resultados)
-    
+
+    df = pd.DataFrame([{
+        'Instância': r['instance'],
+        'Método': r['method'],
+        'Custo': r['cost'],
+        'Gap (%)': r['gap'],
+        'Tempo (s)': r['time'],
+    } for r in registros])
+    df['Custo'] = pd.to_numeric(df['Custo'])
+
+    # Telemetria completa (contadores da busca e tempos das fases)
+    telemetria = pd.DataFrame([{**{campo: r.get(campo) for campo in CAMPOS_TELEMETRIA},
+                                **{f'fase_{nome}': segundos for nome, segundos in r['fases'].items()}}
+                               for r in registros])
+    if not os.path.exists('resultados'):
+        os.makedirs('resultados')
+    telemetria.to_csv('resultados/telemetria.csv', index=False)
+
     # Ordena as instâncias
     df['Tipo'] = df['Instância'].apply(lambda x: x.split('_')[0])
-    df['Numero'] = df['Instância'].apply(lambda x: int(x.split('_')[1]))
+    df['Numero'] = df['Instância'].apply(numero_instancia)
     df = df.sort_values(['Tipo', 'Numero'])
     
     return df[['Instância', 'Método', 'Custo', 'Gap (%)', 'Tempo (s)']]
@@ -61,7 +68,7 @@ def gera_tabelas():
     df = processa_logs()
     
     if df.empty:
-        print("Nenhum resultado encontrado nos logs!")
+        print("Nenhum resultado encontrado em logs/*.json!")
         return
         
     # Tabela 1: Resultados por tamanho de instância
@@ -0,0 +1,24 @@
+#include "tsp_common.h"
+#include <time.h>
+
+/**
+ * Utilitários compartilhados pelos benchmarks (bench_load e bench_solver):
+ * relógio e a instância sintética (tsp_synth.c) de cada tamanho medido
+ */
+
+// Tempo de relógio em segundos
+double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Gera a instância sintética uniforme do tsp_gen com a semente dada, no
+// formato texto. A folga padrão do orçamento torna toda rota viável, então
+// nada é podado pelo tempo
+int bench_write_instance(const char* filename, int n, unsigned int seed) {
+    SynthParams params;
+    synth_defaults(&params, n);
+    params.seed = seed;
+    return synth_write(&params, filename, 0, NULL);
+}
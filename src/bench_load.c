@@ -0,0 +1,156 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Compara o tempo de carga de uma instância no formato texto
+ * (read_instance), no formato binário mapeado (read_instance_bin) e com o
+ * leitor antigo, que chamava fscanf para cada número (referência)
+ *
+ * Para cada n gera uma instância sintética em texto, converte para o
+ * formato binário e mede as três cargas. Como o mapeamento só lê as
+ * páginas quando são acessadas, a carga binária também é medida junto com
+ * uma passada completa pela matriz de custos.
+ *
+ * Uso: bench_load [-r repetições] [-d diretório] [n ...]   (padrão: 1000 2000 5000)
+ */
+
+// Leitor de referência: um fscanf por número, como o read_instance antigo.
+// Retorna a soma dos custos dist * (1 + risco)
+static double fscanf_load(const char* filename) {
+    FILE* f = fopen(filename, "r");
+    if (!f) return 0.0;
+    int n;
+    if (fscanf(f, "%d", &n) != 1) n = 0;
+    for (int i = 0; i < n; i++) {
+        char name[100];
+        int power, min_time;
+        double loyalty;
+        if (fscanf(f, "%99s %d %lf %d", name, &power, &loyalty, &min_time) != 4) break;
+    }
+    size_t cells = (size_t)n * n;
+    double* dist = (double*)malloc(cells * sizeof(double));
+    double sum = 0.0;
+    for (size_t k = 0; k < cells; k++) {
+        if (fscanf(f, "%lf", &dist[k]) != 1) break;
+    }
+    for (size_t k = 0; k < cells; k++) {
+        double risk;
+        if (fscanf(f, "%lf", &risk) != 1) break;
+        sum += dist[k] * (1.0 + risk);
+    }
+    free(dist);
+    fclose(f);
+    return sum;
+}
+
+// Soma a matriz de custos (força a leitura de todas as páginas)
+static double touch(const Instance* inst) {
+    double sum = 0.0;
+    size_t count = (size_t)inst->n * inst->n;
+    for (size_t k = 0; k < count; k++) {
+        sum += inst->cost[k];
+    }
+    return sum;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Mediana de r tempos
+static double median(double* t, int r) {
+    qsort(t, r, sizeof(double), compare_double);
+    return r % 2 ? t[r / 2] : (t[r / 2 - 1] + t[r / 2]) / 2.0;
+}
+
+int main(int argc, char** argv) {
+    int runs = 3;
+    const char* dir = "/tmp";
+    int sizes[32];
+    int num_sizes = 0;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-r") == 0 && a + 1 < argc) {
+            runs = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "-d") == 0 && a + 1 < argc) {
+            dir = argv[++a];
+        } else if (num_sizes < 32 && atoi(argv[a]) > 0) {
+            sizes[num_sizes++] = atoi(argv[a]);
+        } else {
+            printf("Uso: %s [-r repetições] [-d diretório] [n ...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (num_sizes == 0) {
+        sizes[num_sizes++] = 1000;
+        sizes[num_sizes++] = 2000;
+        sizes[num_sizes++] = 5000;
+    }
+    if (runs < 1) runs = 1;
+    double* t_fscanf = (double*)malloc(runs * sizeof(double));
+    double* t_text = (double*)malloc(runs * sizeof(double));
+    double* t_map = (double*)malloc(runs * sizeof(double));
+    double* t_touch = (double*)malloc(runs * sizeof(double));
+
+    printf("%6s %12s %12s %12s %14s %10s %10s\n", "n", "fscanf (s)", "texto (s)",
+           "mmap (s)", "mmap+uso (s)", "texto/fsc", "mmap/fsc");
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        char text_file[512], bin_file[512];
+        snprintf(text_file, sizeof(text_file), "%s/bench_load_%d.txt", dir, n);
+        snprintf(bin_file, sizeof(bin_file), "%s/bench_load_%d.bin", dir, n);
+        if (!bench_write_instance(text_file, n, 12345u + n)) {
+            return 1;
+        }
+
+        double checksum = 0.0;
+        for (int r = 0; r < runs; r++) {
+            double start = bench_now();
+            fscanf_load(text_file);
+            t_fscanf[r] = bench_now() - start;
+        }
+        for (int r = 0; r < runs; r++) {
+            double start = bench_now();
+            Instance* inst = read_instance(text_file);
+            t_text[r] = bench_now() - start;
+            if (!inst) return 1;
+            checksum = touch(inst);
+            if (r == 0 && !write_instance_bin(inst, bin_file)) {
+                return 1;
+            }
+            free_instance(inst);
+        }
+
+        for (int r = 0; r < runs; r++) {
+            double start = bench_now();
+            Instance* inst = read_instance_bin(bin_file);
+            t_map[r] = bench_now() - start;
+            if (!inst) return 1;
+            double sum = touch(inst);
+            t_touch[r] = bench_now() - start;
+            if (sum != checksum) {
+                printf("Erro: matriz binária difere da matriz do texto (n = %d)\n", n);
+                return 1;
+            }
+            free_instance(inst);
+        }
+
+        double reference = median(t_fscanf, runs);
+        double text = median(t_text, runs);
+        double touched = median(t_touch, runs);
+        printf("%6d %12.4f %12.4f %12.6f %14.4f %9.1fx %9.1fx\n", n, reference, text,
+               median(t_map, runs), touched, text > 0 ? reference / text : 0.0,
+               touched > 0 ? reference / touched : 0.0);
+        remove(text_file);
+        remove(bin_file);
+    }
+
+    free(t_fscanf);
+    free(t_text);
+    free(t_map);
+    free(t_touch);
+    return 0;
+}
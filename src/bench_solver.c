@@ -0,0 +1,231 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Micro-benchmarks dos laços internos dos métodos
+ *
+ * Para cada n gera uma instância sintética (sempre a mesma para o mesmo n)
+ * e mede, por chamada: a leitura do texto (read_instance), calculate_cost,
+ * calculate_initial_bound, calculate_bound e uma expansão de nó do BB na
+ * raiz (com Held-Karp nos filhos) e no meio da rota, e a montagem do modelo
+ * do PLI (MTZ e só graus; apenas com GLPK).
+ *
+ * Cada amostra repete a chamada até somar cerca de -t milissegundos (o
+ * número de repetições é calibrado no aquecimento e fixo depois dele); a
+ * saída traz mediana e p99 por chamada. A ordem e o formato das linhas não
+ * mudam entre execuções, e a última coluna é um resultado determinístico da
+ * chamada (custo, limite, filhos gerados, não nulos): o diff da saída de dois
+ * commits mostra a diferença de tempo e também se algum resultado mudou.
+ *
+ * Uso: bench_solver [-r amostras] [-w aquecimento] [-t ms] [-f filtro] [-d diretório] [n ...]
+ *      (padrão: 101 amostras, 5 de aquecimento, 1 ms, n = 12 50 200 1000)
+ */
+
+// Dados de um tamanho de instância compartilhados pelos benchmarks
+typedef struct {
+    const char* file;
+    Instance* inst;
+    int* route;         // Rota do vizinho mais próximo
+    BBBench* root;      // Nó raiz
+    BBBench* middle;    // Nó na metade da rota
+} BenchData;
+
+static double run_read_instance(BenchData* d) {
+    Instance* inst = read_instance(d->file);
+    double n = inst ? inst->n : -1;
+    free_instance(inst);
+    return n;
+}
+
+static double run_calculate_cost(BenchData* d) {
+    return calculate_cost(d->inst, d->route);
+}
+
+static double run_initial_bound(BenchData* d) {
+    return calculate_initial_bound(d->inst);
+}
+
+static double run_bound_root(BenchData* d) {
+    return bb_bench_bound(d->root);
+}
+
+static double run_bound_middle(BenchData* d) {
+    return bb_bench_bound(d->middle);
+}
+
+static double run_expand_root(BenchData* d) {
+    return bb_bench_expand(d->root);
+}
+
+static double run_expand_middle(BenchData* d) {
+    return bb_bench_expand(d->middle);
+}
+
+#ifndef NO_GLPK
+static double run_mip_mtz(BenchData* d) {
+    return mip_bench_build(d->inst, 1);
+}
+
+static double run_mip_dfj(BenchData* d) {
+    return mip_bench_build(d->inst, 0);
+}
+#endif
+
+typedef struct {
+    const char* name;
+    double (*run)(BenchData* d);
+    int max_n;          // Maior n medido (0 = todos)
+} Benchmark;
+
+// A expansão na raiz calcula Held-Karp para cada filho, O(n³) por chamada
+// (cerca de 1 s com n = 200), e só é medida nas instâncias pequenas
+static const Benchmark benchmarks[] = {
+    { "read_instance",           run_read_instance,  0 },
+    { "calculate_cost",          run_calculate_cost, 0 },
+    { "calculate_initial_bound", run_initial_bound,  0 },
+    { "calculate_bound/raiz",    run_bound_root,     0 },
+    { "calculate_bound/meio",    run_bound_middle,   0 },
+    { "expand/raiz",             run_expand_root,    50 },
+    { "expand/meio",             run_expand_middle,  0 },
+#ifndef NO_GLPK
+    { "mip_build/mtz",           run_mip_mtz,        0 },
+    { "mip_build/dfj",           run_mip_dfj,        0 },
+#endif
+};
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Mediana de r tempos ordenados
+static double median(const double* t, int r) {
+    return r % 2 ? t[r / 2] : (t[r / 2 - 1] + t[r / 2]) / 2.0;
+}
+
+// Percentil 99 (posto mais próximo) de r tempos ordenados
+static double p99(const double* t, int r) {
+    int k = (99 * r + 99) / 100;
+    return t[k - 1];
+}
+
+// Mede um benchmark: aquecimento (que também calibra as repetições por
+// amostra) seguido de r amostras. Tempos em ns por chamada
+static void measure(const Benchmark* b, BenchData* d, int n, int samples,
+                    int warmup, double sample_time, double* t) {
+    double result = b->run(d);
+    double start = bench_now();
+    b->run(d);
+    double single = bench_now() - start;
+    long iters = single > 0 ? (long)(sample_time / single) : 1000000;
+    if (iters < 1) iters = 1;
+    if (iters > 1000000) iters = 1000000;
+
+    volatile double sink = 0.0;
+    for (int s = -warmup; s < samples; s++) {
+        start = bench_now();
+        for (long i = 0; i < iters; i++) {
+            sink += b->run(d);
+        }
+        if (s >= 0) {
+            t[s] = (bench_now() - start) * 1e9 / iters;
+        }
+    }
+    (void)sink;
+
+    qsort(t, samples, sizeof(double), compare_double);
+    printf("%-24s %6d %9ld %14.1f %14.1f %16.6g\n", b->name, n, iters,
+           median(t, samples), p99(t, samples), result);
+    fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    int samples = 101;
+    int warmup = 5;
+    double sample_ms = 1.0;
+    const char* filter = NULL;
+    const char* dir = "/tmp";
+    int sizes[32];
+    int num_sizes = 0;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-r") == 0 && a + 1 < argc) {
+            samples = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "-w") == 0 && a + 1 < argc) {
+            warmup = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "-t") == 0 && a + 1 < argc) {
+            sample_ms = atof(argv[++a]);
+        } else if (strcmp(argv[a], "-f") == 0 && a + 1 < argc) {
+            filter = argv[++a];
+        } else if (strcmp(argv[a], "-d") == 0 && a + 1 < argc) {
+            dir = argv[++a];
+        } else if (num_sizes < 32 && atoi(argv[a]) > 3) {
+            sizes[num_sizes++] = atoi(argv[a]);
+        } else {
+            printf("Uso: %s [-r amostras] [-w aquecimento] [-t ms] [-f filtro] "
+                   "[-d diretório] [n ...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (num_sizes == 0) {
+        sizes[num_sizes++] = 12;
+        sizes[num_sizes++] = 50;
+        sizes[num_sizes++] = 200;
+        sizes[num_sizes++] = 1000;
+    }
+    if (samples < 1) samples = 1;
+    if (warmup < 0) warmup = 0;
+
+    init_config(&config);
+    simd_init();
+    double* t = (double*)malloc(samples * sizeof(double));
+    int num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("# kernels %s, hk_depth %d, %d amostras, aquecimento %d, %.3g ms por amostra\n",
+           simd.name, config.hk_depth, samples, warmup, sample_ms);
+    printf("%-24s %6s %9s %14s %14s %16s\n", "benchmark", "n", "iter",
+           "mediana (ns)", "p99 (ns)", "resultado");
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        char file[512];
+        snprintf(file, sizeof(file), "%s/bench_solver_%d.txt", dir, n);
+        if (!bench_write_instance(file, n, 12345u + n)) {
+            return 1;
+        }
+        BenchData d;
+        d.file = file;
+        d.inst = read_instance(file);
+        if (!d.inst) {
+            return 1;
+        }
+        d.route = (int*)malloc(n * sizeof(int));
+        nearest_neighbour_tour(d.inst, d.route);
+        d.root = bb_bench_create(d.inst, 0);
+        d.middle = bb_bench_create(d.inst, n / 2);
+        if (!d.root || !d.middle) {
+            fprintf(stderr, "Memória insuficiente para os nós do BB (n = %d)\n", n);
+            remove(file);
+            return 1;
+        }
+
+        for (int b = 0; b < num_benchmarks; b++) {
+            const Benchmark* bench = &benchmarks[b];
+            if ((bench->max_n > 0 && n > bench->max_n) ||
+                (filter && !strstr(bench->name, filter))) {
+                continue;
+            }
+            measure(bench, &d, n, samples, warmup, sample_ms / 1000.0, t);
+        }
+
+        bb_bench_free(d.root);
+        bb_bench_free(d.middle);
+        free(d.route);
+        free_instance(d.inst);
+        remove(file);
+    }
+
+    free(t);
+    return 0;
+}
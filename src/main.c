@@ -1,53 +1,628 @@
 #include "tsp_common.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <getopt.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <signal.h>
+#include <sys/stat.h>
+
+// Método padrão deste executável (tsp_mip e tsp_dp são o mesmo programa com
+// outro padrão); todos os métodos podem ser escolhidos com --engine
+#ifndef DEFAULT_ENGINE
+#define DEFAULT_ENGINE ENGINE_BB
+#endif
+
+// Imprime modo de uso e opções disponíveis
+static void print_usage(const char* prog) {
+    printf("Uso: %s [opções] arquivo_instancia\n", prog);
+    printf("     %s [opções] --batch arquivo_ou_diretório ...\n", prog);
+    printf("Opções:\n");
+    printf("  --engine NOME      Método: bb, mip, dp ou lk (padrão %s)%s\n",
+           engine_name(DEFAULT_ENGINE),
+           engine_available(ENGINE_MIP) ? "" : "; mip indisponível (compilado sem GLPK)");
+    printf("  --portfolio[=LISTA] Roda os métodos da lista (ex.: bb,mip,lk) ao mesmo tempo, "
+           "com rota compartilhada, até um provar o ótimo ou o gap alvo\n");
+    printf("  --hk-depth N       Usa o limite de Held-Karp até a profundidade N "
+           "(0 = só raiz, -1 = desligado; padrão %d)\n", config.hk_depth);
+    printf("  --hk-iter N        Iterações de subgradiente na raiz (padrão %d)\n", 
+           config.hk_root_iter);
+    printf("  --hk-node-iter N   Iterações de subgradiente nos demais nós (padrão %d)\n",
+           config.hk_node_iter);
+    printf("  --threads N        Threads do Branch and Bound, com roubo de trabalho "
+           "(padrão %d)\n", config.threads);
+    printf("  --strategy NOME    Seleção de nós: best, dfs, dive ou cyclic (padrão %s)\n",
+           strategy_name(config.strategy));
+    printf("  --dive-freq N      Seleções pelo menor bound entre mergulhos da "
+           "estratégia dive (padrão %d)\n", config.dive_freq);
+    printf("  --max-open-mb MB   Memória dos nós abertos a partir da qual a busca "
+           "segue em profundidade (0 = sem limite; padrão %d)\n", config.max_open_mb);
+    printf("  --dominance-mb MB  Memória da tabela de dominância do BB, que descarta "
+           "caminhos parciais mais caros para o mesmo estado (0 = desligada; padrão %d)\n",
+           config.dominance_mb);
+    printf("  --time-limit S     Tempo limite em segundos de cada método (padrão %.0f)\n",
+           config.time_limit);
+    printf("  --node-limit N     Nós explorados pelo BB ou pelo PLI antes de parar "
+           "(0 = sem limite; padrão %lld)\n", config.node_limit);
+    printf("  --mem-limit MB     Memória residente do processo a partir da qual a busca "
+           "para (0 = sem limite; padrão %d)\n", config.mem_limit_mb);
+    printf("  --gap PCT          Gap em %% que encerra a busca (padrão: 0 no BB, 1 no PLI "
+           "e no portfólio)\n");
+    printf("  --no-heuristic     Não usa a rota heurística inicial no BB e no PLI\n");
+    printf("  --dp-mem-mb MB     Memória máxima das tabelas da programação dinâmica "
+           "(padrão %d)\n", config.dp_mem_mb);
+    printf("  --lk-k N           Candidatos por cidade na heurística LK (padrão %d)\n",
+           config.lk_neighbours);
+    printf("  --lk-time S        Tempo em segundos da heurística LK (padrão %.0f)\n",
+           config.lk_time);
+    printf("  --formulation NOME Eliminação de subciclos do PLI: mtz ou dfj (cortes "
+           "sob demanda; padrão %s)\n", formulation_name(config.formulation));
+    printf("  --mip-names        Dá nomes às linhas e colunas do modelo do PLI\n");
+    printf("  --initial-tour ARQ Rota inicial do PLI (índices ou nomes das cidades; "
+           "aceita a saída de --write-tour)\n");
+    printf("  --write-tour ARQ   Grava custo, gap, tempo, viabilidade e rota em ARQ "
+           "(no modo lote, ARQ é um diretório)\n");
+    printf("  --batch            Resolve várias instâncias (arquivos ou diretórios) "
+           "em um conjunto de threads, as maiores primeiro\n");
+    printf("  --jobs N           Instâncias resolvidas ao mesmo tempo no modo lote "
+           "(padrão: número de núcleos, %ld)\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("  --log-level NIVEL  Detalhe dos logs: error, info ou debug (matriz de custos; "
+           "padrão %s)\n", log_level_name(config.log_level));
+    printf("  --progress S       Intervalo em segundos entre registros de progresso no log "
+           "(padrão %.0f)\n", config.progress_interval);
+    printf("  --telemetry-csv ARQ Acrescenta ao CSV uma linha de telemetria por execução "
+           "(além de logs/<instância>_<método>.json)\n");
+}
+
+// SIGINT/SIGTERM: pede que os métodos parem e devolvam a melhor rota. O
+// tratador volta ao padrão após o primeiro sinal, e um segundo encerra o
+// processo na hora
+static void handle_stop_signal(int sig) {
+    (void)sig;
+    static const char message[] =
+        "\nInterrompendo: a busca será encerrada com a melhor rota encontrada\n";
+    request_stop();
+    ssize_t written = write(STDERR_FILENO, message, sizeof(message) - 1);
+    (void)written;
+}
+
+static void install_signal_handlers(void) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESETHAND;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+}
+
+// Tempo de relógio em segundos
+static double wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Resolve a instância com o método configurado ou com o portfólio
+static Solution* solve_instance(const Instance* inst, const char* instance_file,
+                                const int* initial_route) {
+    if (config.portfolio_size > 0) {
+        return solve_portfolio(inst, instance_file, initial_route,
+                               config.portfolio, config.portfolio_size);
+    }
+    return solve_engine(config.engine, inst, instance_file, initial_route);
+}
+
+// Imprime o resultado de uma instância
+static void print_result(const Instance* inst, const char* instance_file, const Solution* sol) {
+    printf("Instância: %s\n", instance_file);
+    if (config.portfolio_size > 0) {
+        printf("Método: Portfólio (");
+        for (int k = 0; k < config.portfolio_size; k++) {
+            printf("%s%s", k ? ", " : "", engine_name(config.portfolio[k]));
+        }
+        printf("); melhor rota: %s\n", sol->feasible ? engine_title(sol->engine) : "-");
+    } else {
+        printf("Método: %s\n", engine_title(sol->engine));
+    }
+    // Sem solução viável não há custo nem rota
+    if (sol->feasible) {
+        printf("Custo: %.2f\n", sol->cost);
+    } else {
+        printf("Custo: -\n");
+    }
+    printf("Tempo: %.2f s\n", sol->time);
+    printf("Gap: %.2f%%\n", sol->gap);
+    printf("Viável: %s\n", sol->feasible ? "Sim" : "Não");
+    
+    if (sol->feasible) {
+        printf("Rota:");
+        for (int i = 0; i < inst->n && sol->route[i] >= 0; i++) {
+            printf(" %s", inst->houses[sol->route[i]].name);
+        }
+        printf("\n");
+    } else {
+        printf("Rota: -\n");
+    }
+}
+
+// Uma instância do modo lote e o resumo do seu resultado
+typedef struct {
+    char* file;
+    int n;                  // Cidades (as maiores são escalonadas primeiro)
+    int solved;
+    int skipped;            // Não iniciada por causa de uma interrupção
+    double cost;
+    double time;
+    double gap;
+    int feasible;
+} BatchJob;
+
+// Lista de instâncias do modo lote, consumida pelas threads em ordem
+typedef struct {
+    BatchJob* jobs;
+    int count;
+    int capacity;
+    atomic_int next;        // Próxima instância a resolver
+} Batch;
+
+static void batch_add(Batch* batch, const char* file) {
+    if (batch->count == batch->capacity) {
+        batch->capacity = batch->capacity ? 2 * batch->capacity : 16;
+        batch->jobs = (BatchJob*)realloc(batch->jobs, batch->capacity * sizeof(BatchJob));
+    }
+    BatchJob* job = &batch->jobs[batch->count++];
+    memset(job, 0, sizeof(*job));
+    job->file = strdup(file);
+    job->n = instance_cities(file);
+}
+
+static int compare_names(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// Adiciona um arquivo, ou os arquivos regulares de um diretório em ordem alfabética
+static int batch_add_path(Batch* batch, const char* path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "Arquivo não encontrado: %s\n", path);
+        return 0;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        batch_add(batch, path);
+        return 1;
+    }
+    DIR* dir = opendir(path);
+    if (!dir) {
+        fprintf(stderr, "Erro ao abrir diretório %s\n", path);
+        return 0;
+    }
+    char** names = NULL;
+    int count = 0, capacity = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        size_t len = strlen(path) + strlen(entry->d_name) + 2;
+        char* file = (char*)malloc(len);
+        snprintf(file, len, "%s/%s", path, entry->d_name);
+        if (stat(file, &st) != 0 || !S_ISREG(st.st_mode)) {
+            free(file);
+            continue;
+        }
+        if (count == capacity) {
+            capacity = capacity ? 2 * capacity : 16;
+            names = (char**)realloc(names, capacity * sizeof(char*));
+        }
+        names[count++] = file;
+    }
+    closedir(dir);
+    qsort(names, count, sizeof(char*), compare_names);
+    for (int i = 0; i < count; i++) {
+        batch_add(batch, names[i]);
+        free(names[i]);
+    }
+    free(names);
+    return 1;
+}
+
+// Maiores instâncias primeiro; empate pela ordem original
+static int compare_jobs(const void* a, const void* b) {
+    const BatchJob* x = (const BatchJob*)a;
+    const BatchJob* y = (const BatchJob*)b;
+    if (x->n != y->n) return y->n - x->n;
+    return strcmp(x->file, y->file);
+}
+
+// Nome de uma instância do lote e o arquivo de origem
+typedef struct {
+    char name[256];
+    const char* file;
+} BatchName;
+
+static int compare_batch_names(const void* a, const void* b) {
+    const BatchName* x = (const BatchName*)a;
+    const BatchName* y = (const BatchName*)b;
+    int cmp = strcmp(x->name, y->name);
+    return cmp ? cmp : strcmp(x->file, y->file);
+}
+
+// Logs, telemetria e rotas são nomeados pelo nome da instância: duas
+// instâncias com o mesmo nome (a/x.txt e b/x.txt, ou x.txt e x.bin)
+// gravariam os mesmos arquivos ao mesmo tempo. Recusa o lote nesse caso
+static int batch_unique_names(const Batch* batch) {
+    BatchName* names = (BatchName*)malloc(batch->count * sizeof(BatchName));
+    for (int k = 0; k < batch->count; k++) {
+        instance_base_name(batch->jobs[k].file, names[k].name, sizeof(names[k].name));
+        names[k].file = batch->jobs[k].file;
+    }
+    qsort(names, batch->count, sizeof(BatchName), compare_batch_names);
+    int ok = 1;
+    for (int k = 1; k < batch->count; k++) {
+        if (strcmp(names[k - 1].name, names[k].name) == 0) {
+            fprintf(stderr, "Instâncias com o mesmo nome no lote: %s e %s\n",
+                    names[k - 1].file, names[k].file);
+            ok = 0;
+        }
+    }
+    free(names);
+    return ok;
+}
+
+// Grava a rota de uma instância do lote em dir/<nome da instância>.tour
+static void batch_write_tour(const char* dir, const char* instance_file,
+                             const Solution* sol, const Instance* inst) {
+    char name[256];
+    instance_base_name(instance_file, name, sizeof(name));
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.tour", dir, name);
+    write_solution(path, sol, inst);
+}
+
+// Thread do modo lote: retira a próxima instância da lista até esvaziá-la.
+// Cada instância tem o próprio log (log_file é local à thread) e o seu
+// resultado é impresso de uma vez, sem intercalar com as outras threads
+static void* batch_worker(void* arg) {
+    Batch* batch = (Batch*)arg;
+    for (;;) {
+        int k = atomic_fetch_add(&batch->next, 1);
+        if (k >= batch->count) break;
+        BatchJob* job = &batch->jobs[k];
+        if (stop_requested()) {
+            job->skipped = 1;
+            continue;
+        }
+
+        Instance* inst = read_instance(job->file);
+        if (!inst) continue;
+        Solution* sol = solve_instance(inst, job->file, NULL);
+        if (sol) {
+            job->solved = 1;
+            job->cost = sol->cost;
+            job->time = sol->time;
+            job->gap = sol->gap;
+            job->feasible = sol->feasible;
+
+            flockfile(stdout);
+            print_result(inst, job->file, sol);
+            printf("\n");
+            fflush(stdout);
+            funlockfile(stdout);
+
+            if (config.tour_output) {
+                batch_write_tour(config.tour_output, job->file, sol, inst);
+            }
+            free_solution(sol);
+        }
+        free_instance(inst);
+    }
+    engine_thread_done();
+    return NULL;
+}
+
+// Resolve todas as instâncias da lista com jobs threads e imprime um resumo
+static int run_batch(Batch* batch, int jobs) {
+    if (batch->count == 0) {
+        fprintf(stderr, "Nenhuma instância para o modo lote\n");
+        return 1;
+    }
+    int safe = config.portfolio_size > 0 ?
+        engines_thread_safe(config.portfolio, config.portfolio_size) :
+        engines_thread_safe(&config.engine, 1);
+    if (jobs > 1 && !safe) {
+        fprintf(stderr, "GLPK compilado sem TLS: resolvendo uma instância por vez\n");
+        jobs = 1;
+    }
+    if (jobs > batch->count) {
+        jobs = batch->count;
+    }
+    qsort(batch->jobs, batch->count, sizeof(BatchJob), compare_jobs);
+    atomic_init(&batch->next, 0);
+
+    double start = wall_time();
+    pthread_t* threads = (pthread_t*)malloc(jobs * sizeof(pthread_t));
+    for (int t = 1; t < jobs; t++) {
+        pthread_create(&threads[t], NULL, batch_worker, batch);
+    }
+    batch_worker(batch);
+    for (int t = 1; t < jobs; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    double elapsed = wall_time() - start;
+
+    // Resumo: soma dos tempos de cada instância contra o tempo decorrido
+    int failed = 0, skipped = 0;
+    double total = 0.0;
+    printf("Resumo do lote (%d instâncias, %d threads):\n", batch->count, jobs);
+    printf("%-40s %6s %12s %10s %8s %7s\n", "Instância", "n", "Custo", "Tempo (s)",
+           "Gap (%)", "Viável");
+    for (int k = 0; k < batch->count; k++) {
+        const BatchJob* job = &batch->jobs[k];
+        if (job->skipped) {
+            printf("%-40s %6d %12s\n", job->file, job->n, "interrompida");
+            skipped++;
+            continue;
+        }
+        if (!job->solved) {
+            printf("%-40s %6d %12s\n", job->file, job->n, "erro");
+            failed++;
+            continue;
+        }
+        char cost[32] = "-";
+        if (job->feasible) {
+            snprintf(cost, sizeof(cost), "%.2f", job->cost);
+        }
+        printf("%-40s %6d %12s %10.2f %8.2f %7s\n", job->file, job->n, cost,
+               job->time, job->gap, job->feasible ? "Sim" : "Não");
+        total += job->time;
+    }
+    printf("Tempo somado: %.2f s, tempo decorrido: %.2f s\n", total, elapsed);
+    if (skipped) {
+        printf("Lote interrompido: %d instâncias não resolvidas\n", skipped);
+    }
+    return failed || skipped ? 1 : 0;
+}
 
 int main(int argc, char** argv) {
-    if (argc != 2) {
-        printf("Uso: %s arquivo_instancia\n", argv[0]);
+    init_config(&config);
+    config.engine = DEFAULT_ENGINE;
+    simd_init();
+    int batch_mode = 0;
+    int jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (jobs < 1) jobs = 1;
+    
+    static struct option long_options[] = {
+        {"engine",       required_argument, 0, 'e'},
+        {"portfolio",    optional_argument, 0, 'P'},
+        {"hk-depth",     required_argument, 0, 'd'},
+        {"hk-iter",      required_argument, 0, 'i'},
+        {"hk-node-iter", required_argument, 0, 'k'},
+        {"threads",      required_argument, 0, 't'},
+        {"strategy",     required_argument, 0, 's'},
+        {"dive-freq",    required_argument, 0, 'f'},
+        {"max-open-mb",  required_argument, 0, 'm'},
+        {"dominance-mb", required_argument, 0, 'D'},
+        {"dp-mem-mb",    required_argument, 0, 'p'},
+        {"time-limit",   required_argument, 0, 'L'},
+        {"node-limit",   required_argument, 0, 'n'},
+        {"mem-limit",    required_argument, 0, 'M'},
+        {"gap",          required_argument, 0, 'G'},
+        {"no-heuristic", no_argument,       0, 'H'},
+        {"lk-k",         required_argument, 0, 'K'},
+        {"lk-time",      required_argument, 0, 'T'},
+        {"formulation",  required_argument, 0, 'F'},
+        {"mip-names",    no_argument,       0, 'N'},
+        {"initial-tour", required_argument, 0, 'I'},
+        {"write-tour",   required_argument, 0, 'W'},
+        {"batch",        no_argument,       0, 'B'},
+        {"jobs",         required_argument, 0, 'j'},
+        {"log-level",    required_argument, 0, 'g'},
+        {"progress",     required_argument, 0, 'R'},
+        {"telemetry-csv", required_argument, 0, 'C'},
+        {"help",         no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+    
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'e':
+                if (!parse_engine(optarg, &config.engine)) {
+                    fprintf(stderr, "Método desconhecido: %s\n", optarg);
+                    return 1;
+                }
+                if (!engine_available(config.engine)) {
+                    fprintf(stderr, "Método indisponível neste executável: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'P':
+                // Sem lista: todos os métodos disponíveis exceto a programação
+                // dinâmica, que só cabe na memória para instâncias pequenas
+                config.portfolio_size = parse_engine_list(optarg ? optarg :
+                    engine_available(ENGINE_MIP) ? "bb,mip,lk" : "bb,lk", config.portfolio);
+                if (config.portfolio_size == 0) {
+                    fprintf(stderr, "Lista de métodos inválida: %s\n", optarg);
+                    return 1;
+                }
+                for (int k = 0; k < config.portfolio_size; k++) {
+                    if (!engine_available(config.portfolio[k])) {
+                        fprintf(stderr, "Método indisponível neste executável: %s\n",
+                                engine_name(config.portfolio[k]));
+                        return 1;
+                    }
+                }
+                break;
+            case 'd': config.hk_depth = atoi(optarg); break;
+            case 'i': config.hk_root_iter = atoi(optarg); break;
+            case 'k': config.hk_node_iter = atoi(optarg); break;
+            case 't':
+                config.threads = atoi(optarg);
+                if (config.threads < 1) {
+                    fprintf(stderr, "Número de threads inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 's':
+                if (!parse_strategy(optarg, &config.strategy)) {
+                    fprintf(stderr, "Estratégia desconhecida: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'f':
+                config.dive_freq = atoi(optarg);
+                if (config.dive_freq < 1) {
+                    fprintf(stderr, "Frequência de mergulho inválida: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'm': config.max_open_mb = atoi(optarg); break;
+            case 'D':
+                config.dominance_mb = atoi(optarg);
+                if (config.dominance_mb < 0) {
+                    fprintf(stderr, "Memória da tabela de dominância inválida: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'p': config.dp_mem_mb = atoi(optarg); break;
+            case 'L':
+                config.time_limit = atof(optarg);
+                if (config.time_limit <= 0.0) {
+                    fprintf(stderr, "Tempo limite inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'n':
+                config.node_limit = atoll(optarg);
+                if (config.node_limit < 0) {
+                    fprintf(stderr, "Limite de nós inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'M':
+                config.mem_limit_mb = atoi(optarg);
+                if (config.mem_limit_mb < 0) {
+                    fprintf(stderr, "Limite de memória inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'G':
+                config.target_gap = atof(optarg);
+                if (config.target_gap < 0.0 || config.target_gap >= 100.0) {
+                    fprintf(stderr, "Gap alvo inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'H': config.heuristic = 0; break;
+            case 'K':
+                config.lk_neighbours = atoi(optarg);
+                if (config.lk_neighbours < 1) {
+                    fprintf(stderr, "Número de candidatos inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'T': config.lk_time = atof(optarg); break;
+            case 'F':
+                if (!parse_formulation(optarg, &config.formulation)) {
+                    fprintf(stderr, "Formulação desconhecida: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'N': config.mip_names = 1; break;
+            case 'I': config.initial_tour = optarg; break;
+            case 'W': config.tour_output = optarg; break;
+            case 'B': batch_mode = 1; break;
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs < 1) {
+                    fprintf(stderr, "Número de instâncias simultâneas inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'g':
+                if (!parse_log_level(optarg, &config.log_level)) {
+                    fprintf(stderr, "Nível de log desconhecido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'R':
+                config.progress_interval = atof(optarg);
+                if (config.progress_interval <= 0.0) {
+                    fprintf(stderr, "Intervalo de progresso inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'C': config.telemetry_csv = optarg; break;
+            case 'h': print_usage(argv[0]); return 0;
+            default:  print_usage(argv[0]); return 1;
+        }
+    }
+    install_signal_handlers();
+    
+    if (batch_mode) {
+        if (optind >= argc) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (config.initial_tour) {
+            fprintf(stderr, "--initial-tour não pode ser usada com --batch\n");
+            return 1;
+        }
+        Batch batch;
+        memset(&batch, 0, sizeof(batch));
+        int ok = 1;
+        for (int a = optind; a < argc; a++) {
+            ok = batch_add_path(&batch, argv[a]) && ok;
+        }
+        int status = ok && batch_unique_names(&batch) ? run_batch(&batch, jobs) : 1;
+        for (int k = 0; k < batch.count; k++) {
+            free(batch.jobs[k].file);
+        }
+        free(batch.jobs);
+        return status;
+    }
+    
+    if (optind != argc - 1) {
+        print_usage(argv[0]);
         return 1;
     }
+    const char* instance_file = argv[optind];
     
     // Lê instância
-    Instance* inst = read_instance(argv[1]);
+    Instance* inst = read_instance(instance_file);
     if (!inst) {
         return 1;
     }
     
-    // Resolve
-    Solution* sol;
+    // Rota inicial fornecida (usada pelo PLI)
+    int* initial_route = NULL;
+    if (config.initial_tour) {
+        initial_route = (int*)malloc(inst->n * sizeof(int));
+        if (!read_tour(inst, config.initial_tour, initial_route)) {
+            free(initial_route);
+            free_instance(inst);
+            return 1;
+        }
+    }
     
-    #ifdef USE_BB
-    sol = solve_bb(inst, argv[1]);
-    #else
-    clock_t start = clock();
-    sol = solve_mip(inst, argv[1]);
-    clock_t end = clock();
-    if (sol) {
-        sol->time = ((double)(end - start)) / CLOCKS_PER_SEC;
+    // Resolve
+    Solution* sol = solve_instance(inst, instance_file, initial_route);
+    free(initial_route);
+    if (!sol) {
+        free_instance(inst);
+        return 1;
     }
-    #endif
     
     // Imprime resultado
-    printf("Instância: %s\n", argv[1]);
-    printf("Método: %s\n", 
-    #ifdef USE_BB
-        "Branch and Bound"
-    #else
-        "PLI"
-    #endif
-    );
-    printf("Custo: %.2f\n", sol->cost);
-    printf("Tempo: %.2f s\n", sol->time);
-    printf("Gap: %.2f%%\n", sol->gap);
-    printf("Viável: %s\n", sol->feasible ? "Sim" : "Não");
+    print_result(inst, instance_file, sol);
     
-    printf("Rota:");
-    for (int i = 0; i < inst->n; i++) {
-        printf(" %s", inst->houses[sol->route[i]].name);
+    if (config.tour_output) {
+        write_solution(config.tour_output, sol, inst);
     }
-    printf("\n");
     
     // Libera memória
     free_solution(sol);
@@ -3,9 +3,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <float.h>
+#include <limits.h>
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
 
 // Estrutura para nó do Branch and Bound
+// O nó é alocado pelo NodePool como um único bloco: cabeçalho seguido de
+// path[n] e visited[n], de modo que path/visited apontam para dentro do bloco
 typedef struct Node {
     int level;          // Nível na árvore BB
     int* path;          // Caminho parcial atual
@@ -13,56 +20,302 @@ typedef struct Node {
     double cost;        // Custo acumulado até o nó
     double bound;       // Limite inferior do nó
     int total_time;     // Tempo total acumulado
+    double* pi;         // Penalidades de Held-Karp (NULL se não usadas)
+    uint64_t zobrist;   // Hash Zobrist das cidades visitadas
+    struct Node* next_free; // Próximo bloco livre (usado apenas pelo pool)
 } Node;
 
-// Estrutura para armazenar soluções BB
+// Número de nós alocados de uma vez pelo pool
+#define NODE_POOL_SLAB_NODES 4096
+
+// Slab: bloco grande de memória dividido em nós de tamanho fixo
+typedef struct NodeSlab {
+    struct NodeSlab* next;
+} NodeSlab;
+
+// Pool de nós de tamanho fixo com lista de blocos livres
+typedef struct {
+    int n;                  // Número de cidades (define o tamanho do bloco)
+    int with_pi;            // Reserva espaço para penalidades de Held-Karp
+    size_t pi_offset;       // Deslocamento de pi dentro do bloco
+    size_t block_size;      // Bytes por nó (cabeçalho + path + visited [+ pi])
+    size_t slab_header;     // Bytes reservados para o cabeçalho do slab
+    NodeSlab* slabs;        // Lista de slabs alocados
+    Node* free_list;        // Nós livres para reutilização
+    _Atomic(Node*) remote_free; // Nós devolvidos por outras threads (pilha lock-free)
+    size_t num_slabs;       // Número de slabs alocados
+    size_t live;            // Nós em uso no momento
+    size_t peak_live;       // Pico de nós em uso
+    size_t total_allocs;    // Total de alocações servidas pelo pool
+} NodePool;
+
+// Entrada do heap: a chave fica junto do ponteiro para evitar acessar o nó
 typedef struct {
-    int* route;         // Rota da solução
-    double cost;        // Custo total
-    int total_time;     // Tempo total
-} BBSolution;
+    double bound;       // Chave de prioridade (limite inferior do nó)
+    Node* node;         // Nó aberto
+} HeapEntry;
+
+// Heap binário de mínimo (por bound) com capacidade crescente
+typedef struct {
+    HeapEntry* data;    // Entradas do heap
+    int size;           // Número de nós abertos
+    int capacity;       // Capacidade alocada
+    int peak;           // Pico de nós abertos
+} NodeHeap;
+
+// Capacidade inicial do heap de nós abertos
+#define NODE_HEAP_INITIAL_CAPACITY 1024
+
+// Inicializa heap vazio
+static void heap_init(NodeHeap* heap) {
+    heap->capacity = NODE_HEAP_INITIAL_CAPACITY;
+    heap->data = (HeapEntry*)malloc(heap->capacity * sizeof(HeapEntry));
+    heap->size = 0;
+    heap->peak = 0;
+}
+
+// Insere nó no heap em O(log N), dobrando a capacidade quando necessário
+static int heap_push(NodeHeap* heap, Node* node) {
+    if (heap->size == heap->capacity) {
+        int new_capacity = heap->capacity * 2;
+        HeapEntry* data = (HeapEntry*)realloc(heap->data, 
+                                              new_capacity * sizeof(HeapEntry));
+        if (!data) return 0;
+        heap->data = data;
+        heap->capacity = new_capacity;
+    }
+    
+    // Sobe a nova entrada até a posição correta
+    int i = heap->size++;
+    double bound = node->bound;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap->data[parent].bound <= bound) break;
+        heap->data[i] = heap->data[parent];
+        i = parent;
+    }
+    heap->data[i].bound = bound;
+    heap->data[i].node = node;
+    
+    if (heap->size > heap->peak) {
+        heap->peak = heap->size;
+    }
+    return 1;
+}
+
+// Remove e retorna o nó de menor bound em O(log N)
+static Node* heap_pop(NodeHeap* heap) {
+    if (heap->size == 0) return NULL;
+    
+    Node* top = heap->data[0].node;
+    HeapEntry last = heap->data[--heap->size];
+    
+    // Desce a última entrada a partir da raiz
+    int i = 0;
+    int size = heap->size;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= size) break;
+        if (child + 1 < size && heap->data[child + 1].bound < heap->data[child].bound) {
+            child++;
+        }
+        if (last.bound <= heap->data[child].bound) break;
+        heap->data[i] = heap->data[child];
+        i = child;
+    }
+    if (size > 0) {
+        heap->data[i] = last;
+    }
+    return top;
+}
+
+// Libera o heap (os nós pertencem ao pool)
+static void heap_destroy(NodeHeap* heap) {
+    free(heap->data);
+    heap->data = NULL;
+    heap->size = heap->capacity = 0;
+}
+
+// Arredonda tamanho para múltiplo de align (potência de 2)
+static size_t align_up(size_t size, size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+// Inicializa pool para nós de n cidades
+static void node_pool_init(NodePool* pool, int n, int with_pi) {
+    pool->n = n;
+    pool->with_pi = with_pi;
+    pool->pi_offset = align_up(sizeof(Node) + 2 * n * sizeof(int), sizeof(double));
+    pool->block_size = align_up(pool->pi_offset + (with_pi ? n * sizeof(double) : 0), 16);
+    pool->slab_header = align_up(sizeof(NodeSlab), 16);
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    atomic_init(&pool->remote_free, NULL);
+    pool->num_slabs = 0;
+    pool->live = 0;
+    pool->peak_live = 0;
+    pool->total_allocs = 0;
+}
+
+// Aloca novo slab e coloca seus nós na lista de livres
+static int node_pool_grow(NodePool* pool) {
+    NodeSlab* slab = (NodeSlab*)malloc(pool->slab_header + 
+                                       NODE_POOL_SLAB_NODES * pool->block_size);
+    if (!slab) return 0;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->num_slabs++;
+    
+    // Ponteiros path/visited são fixados uma única vez por bloco
+    char* base = (char*)slab + pool->slab_header;
+    for (int i = NODE_POOL_SLAB_NODES - 1; i >= 0; i--) {
+        Node* node = (Node*)(base + i * pool->block_size);
+        node->path = (int*)(node + 1);
+        node->visited = node->path + pool->n;
+        node->pi = pool->with_pi ? (double*)((char*)node + pool->pi_offset) : NULL;
+        node->next_free = pool->free_list;
+        pool->free_list = node;
+    }
+    return 1;
+}
+
+// Recupera para a lista de livres os nós devolvidos por outras threads.
+// Só o dono do pool esvazia a pilha, e de uma vez, o que evita o problema ABA
+static void node_pool_reclaim(NodePool* pool) {
+    Node* node = atomic_exchange_explicit(&pool->remote_free, NULL, memory_order_acquire);
+    while (node) {
+        Node* next = node->next_free;
+        node->next_free = pool->free_list;
+        pool->free_list = node;
+        pool->live--;
+        node = next;
+    }
+}
+
+// Obtém um nó do pool (conteúdo de path/visited não é inicializado)
+static Node* node_pool_alloc(NodePool* pool) {
+    if (!pool->free_list) {
+        node_pool_reclaim(pool);
+    }
+    if (!pool->free_list && !node_pool_grow(pool)) {
+        return NULL;
+    }
+    Node* node = pool->free_list;
+    pool->free_list = node->next_free;
+    pool->live++;
+    pool->total_allocs++;
+    if (pool->live > pool->peak_live) {
+        pool->peak_live = pool->live;
+    }
+    return node;
+}
+
+// Devolve nó ao pool
+static void node_pool_free(NodePool* pool, Node* node) {
+    node->next_free = pool->free_list;
+    pool->free_list = node;
+    pool->live--;
+}
+
+// Devolve ao pool um nó que pertence a outra thread (o dono o recupera
+// em node_pool_reclaim)
+static void node_pool_free_remote(NodePool* pool, Node* node) {
+    Node* head = atomic_load_explicit(&pool->remote_free, memory_order_relaxed);
+    do {
+        node->next_free = head;
+    } while (!atomic_compare_exchange_weak_explicit(&pool->remote_free, &head, node,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+// Copia o conteúdo de src (de qualquer pool com o mesmo n) para dst
+static void node_copy(const NodePool* pool, Node* dst, const Node* src) {
+    dst->level = src->level;
+    dst->cost = src->cost;
+    dst->bound = src->bound;
+    dst->total_time = src->total_time;
+    dst->zobrist = src->zobrist;
+    memcpy(dst->path, src->path, 2 * pool->n * sizeof(int));
+    if (dst->pi && src->pi) {
+        memcpy(dst->pi, src->pi, pool->n * sizeof(double));
+    }
+}
+
+// Libera todos os slabs do pool
+static void node_pool_destroy(NodePool* pool) {
+    NodeSlab* slab = pool->slabs;
+    while (slab) {
+        NodeSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+}
+
+// Remove do heap todos os nós com bound >= limit, devolvendo-os ao pool.
+// Compacta o vetor e reconstrói o heap em O(N); retorna o número de nós podados
+static int heap_prune(NodeHeap* heap, NodePool* pool, double limit) {
+    int kept = 0;
+    for (int i = 0; i < heap->size; i++) {
+        if (heap->data[i].bound < limit) {
+            heap->data[kept++] = heap->data[i];
+        } else {
+            node_pool_free(pool, heap->data[i].node);
+        }
+    }
+    int pruned = heap->size - kept;
+    heap->size = kept;
+    
+    // Reconstrói a propriedade de heap de baixo para cima
+    for (int start = kept / 2 - 1; start >= 0; start--) {
+        HeapEntry entry = heap->data[start];
+        int i = start;
+        while (1) {
+            int child = 2 * i + 1;
+            if (child >= kept) break;
+            if (child + 1 < kept && heap->data[child + 1].bound < heap->data[child].bound) {
+                child++;
+            }
+            if (entry.bound <= heap->data[child].bound) break;
+            heap->data[i] = heap->data[child];
+            i = child;
+        }
+        heap->data[i] = entry;
+    }
+    return pruned;
+}
 
 // Calcula limite inferior para o nó BB
+// O restante da rota sai da cidade atual, passa uma vez por cada cidade não
+// visitada e volta para KingsLanding. Cada uma dessas arestas parte da cidade
+// atual ou de uma cidade não visitada, então a soma das menores saídas de cada
+// uma delas (mais os tempos mínimos pendentes) nunca excede o custo real.
 double calculate_bound(const Instance* inst, Node* node) {
     if (node->total_time > inst->houses[0].power) 
         return DBL_MAX;
         
     int n = inst->n;
-    double bound = node->cost;  // Custo atual
+    double bound = node->cost;  // Custo atual (arestas + tempos mínimos)
+    int current = node->path[node->level];
     
     // Se é uma solução completa, adiciona custo de retorno
     if (node->level == n-1) {
-        int last = node->path[node->level];
-        bound += inst->dist[last][0] * (1.0 + inst->risk[last][0]);
+        bound += inst->cost[current * n];
         return bound;
     }
     
+    // Menor custo para sair da cidade atual rumo a uma cidade não visitada
+    bound += simd.masked_min(inst->cost + current * n, node->visited, n, -1);
+    
     // Para cada cidade não visitada
     for (int i = 0; i < n; i++) {
         if (!node->visited[i]) {
-            // Menor custo para chegar em i
-            double min_to = DBL_MAX;
-            int current = node->path[node->level];
-            double direct = inst->dist[current][i] * (1.0 + inst->risk[current][i]);
-            min_to = direct;
-            
-            // Menor custo para sair de i
-            double min_from = DBL_MAX;
-            for (int j = 0; j < n; j++) {
-                if (!node->visited[j] && i != j) {
-                    double cost = inst->dist[i][j] * (1.0 + inst->risk[i][j]);
-                    min_from = (cost < min_from) ? cost : min_from;
-                }
-            }
-            
-            // Se é a última cidade não visitada, deve voltar para KingsLanding
-            if (node->level == n-2) {
-                min_from = inst->dist[i][0] * (1.0 + inst->risk[i][0]);
-            }
-            
-            if (min_to != DBL_MAX && min_from != DBL_MAX) {
-                bound += min_to + min_from;
-            }
+            // Menor custo para sair de i: outra cidade não visitada ou KingsLanding
+            const double* row = inst->cost + i * n;
+            double min_from = simd.masked_min(row, node->visited, n, i);
+            min_from = (row[0] < min_from) ? row[0] : min_from;
+            bound += min_from;
             
             // Adiciona tempo mínimo
             bound += inst->houses[i].min_time;
@@ -72,6 +325,90 @@ double calculate_bound(const Instance* inst, Node* node) {
     return bound;
 }
 
+// Tabela por nó pai para avaliar o calculate_bound de todos os filhos em lote.
+// Para cada cidade i não visitada (conjunto U) guarda as duas menores saídas
+// para (U \ {i}) ∪ {KingsLanding}. Quando o filho visita c, só as cidades cuja
+// menor saída ia para c passam a usar a segunda menor: delta[c] acumula essa
+// diferença, e o bound de cada filho sai em O(1) a partir da tabela
+typedef struct {
+    double* best1;      // Menor saída de i para (U \ {i}) ∪ {0}
+    double* best2;      // Segunda menor saída (sem usar arg1[i])
+    double* best_u;     // Menor saída de i para U \ {i} (sem KingsLanding)
+    int* arg1;          // Destino da menor saída de i
+    double* delta;      // Aumento da soma quando a cidade sai de U
+    double sum;         // Σ (best1[i] + min_time[i]) para i em U
+} BoundTable;
+
+// Aloca tabela para n cidades
+static void bound_table_init(BoundTable* table, int n) {
+    table->best1 = (double*)malloc(n * sizeof(double));
+    table->best2 = (double*)malloc(n * sizeof(double));
+    table->best_u = (double*)malloc(n * sizeof(double));
+    table->arg1 = (int*)malloc(n * sizeof(int));
+    table->delta = (double*)malloc(n * sizeof(double));
+    table->sum = 0.0;
+}
+
+// Libera tabela
+static void bound_table_free(BoundTable* table) {
+    free(table->best1);
+    free(table->best2);
+    free(table->best_u);
+    free(table->arg1);
+    free(table->delta);
+}
+
+// Preenche a tabela para o nó pai em O(k²), k = cidades não visitadas
+static void bound_table_build(const Instance* inst, const Node* node, BoundTable* table) {
+    int n = inst->n;
+    const int* visited = node->visited;
+    table->sum = 0.0;
+    
+    for (int i = 0; i < n; i++) {
+        table->delta[i] = 0.0;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        if (visited[i]) continue;
+        
+        // Duas menores saídas para U \ {i}; KingsLanding (visitada) entra à parte
+        const double* row = inst->cost + i * n;
+        double bu, b2;
+        int a1;
+        simd.two_min(row, visited, n, i, &bu, &b2, &a1);
+        double b1 = bu;
+        if (row[0] <= b1) {
+            b2 = b1;
+            b1 = row[0];
+            a1 = 0;
+        } else if (row[0] < b2) {
+            b2 = row[0];
+        }
+        table->best1[i] = b1;
+        table->best2[i] = b2;
+        table->best_u[i] = bu;
+        table->arg1[i] = a1;
+        table->sum += b1 + inst->houses[i].min_time;
+        
+        // Se a1 deixar U, i passa a sair pela segunda menor aresta
+        if (a1 != 0) {
+            table->delta[a1] += b2 - b1;
+        }
+    }
+}
+
+// Bound do filho que visita city (ainda restam cidades não visitadas depois
+// dele). Igual a calculate_bound aplicado ao filho, em O(1)
+static double bound_table_child(const Instance* inst, const BoundTable* table,
+                                int city, double child_cost, int child_time) {
+    if (child_time > inst->houses[0].power) 
+        return DBL_MAX;
+    
+    return child_cost + table->best_u[city] +
+           table->sum - table->best1[city] - inst->houses[city].min_time + 
+           table->delta[city];
+}
+
 // Calcula bound inicial mais preciso
 double calculate_initial_bound(const Instance* inst) {
     int n = inst->n;
@@ -80,20 +417,9 @@ double calculate_initial_bound(const Instance* inst) {
     // Para cada cidade
     for (int i = 0; i < n; i++) {
         // Encontra as duas menores arestas conectadas a i
-        double min1 = DBL_MAX;
-        double min2 = DBL_MAX;
-        
-        for (int j = 0; j < n; j++) {
-            if (i != j) {
-                double cost = inst->dist[i][j] * (1.0 + inst->risk[i][j]);
-                if (cost < min1) {
-                    min2 = min1;
-                    min1 = cost;
-                } else if (cost < min2) {
-                    min2 = cost;
-                }
-            }
-        }
+        double min1, min2;
+        int arg1;
+        simd.two_min(inst->cost + i * n, NULL, n, i, &min1, &min2, &arg1);
         
         // Adiciona metade da soma das duas menores arestas
         if (min1 != DBL_MAX && min2 != DBL_MAX) {
@@ -107,36 +433,1011 @@ double calculate_initial_bound(const Instance* inst) {
     return bound;
 }
 
-// Resolve TSP usando Branch and Bound
-Solution* solve_bb(const Instance* inst, const char* nome_arquivo) {
+// Limite de Held-Karp para o nó: custo acumulado + tempos mínimos pendentes +
+// limite da 1-árvore para as arestas restantes. pi é aquecido e atualizado
+static double calculate_hk_bound(const Instance* inst, HKWorkspace* ws, Node* node,
+                                 double* pi, int max_iter, double incumbent) {
     int n = inst->n;
+    double base = node->cost;
+    for (int i = 0; i < n; i++) {
+        if (!node->visited[i]) {
+            base += inst->houses[i].min_time;
+        }
+    }
     
-    // Extrai apenas o nome base do arquivo, sem o caminho
-    const char* base_name = strrchr(nome_arquivo, '/');
-    if (base_name) {
-        base_name++; // Pula a barra
+    // O nó é podado quando o limite das arestas restantes atinge este valor
+    double target = (incumbent < DBL_MAX) ? incumbent - base : DBL_MAX;
+    return base + held_karp_bound(inst, ws, node->visited, node->path[node->level],
+                                  pi, max_iter, target);
+}
+
+// Pilha de nós abertos usada na busca em profundidade. O dono empilha e
+// desempilha no topo; roubos retiram da base, onde ficam os nós mais rasos
+typedef struct {
+    Node** data;        // Nós em data[head..size)
+    int head;           // Base da pilha
+    int size;           // Topo da pilha
+    int capacity;       // Capacidade alocada
+} NodeStack;
+
+// Inicializa pilha vazia
+static void stack_init(NodeStack* stack) {
+    stack->capacity = NODE_HEAP_INITIAL_CAPACITY;
+    stack->data = (Node**)malloc(stack->capacity * sizeof(Node*));
+    stack->head = 0;
+    stack->size = 0;
+}
+
+// Empilha nó, reaproveitando o espaço liberado na base antes de crescer
+static int stack_push(NodeStack* stack, Node* node) {
+    if (stack->size == stack->capacity) {
+        if (stack->head > 0) {
+            memmove(stack->data, stack->data + stack->head,
+                    (stack->size - stack->head) * sizeof(Node*));
+            stack->size -= stack->head;
+            stack->head = 0;
+        } else {
+            int new_capacity = stack->capacity * 2;
+            Node** data = (Node**)realloc(stack->data, new_capacity * sizeof(Node*));
+            if (!data) return 0;
+            stack->data = data;
+            stack->capacity = new_capacity;
+        }
+    }
+    stack->data[stack->size++] = node;
+    return 1;
+}
+
+// Desempilha o nó do topo (o mais profundo)
+static Node* stack_pop(NodeStack* stack) {
+    if (stack->size == stack->head) return NULL;
+    Node* node = stack->data[--stack->size];
+    if (stack->size == stack->head) {
+        stack->head = stack->size = 0;
+    }
+    return node;
+}
+
+// Retira o nó da base (o mais raso, com a maior subárvore)
+static Node* stack_take_bottom(NodeStack* stack) {
+    if (stack->size == stack->head) return NULL;
+    Node* node = stack->data[stack->head++];
+    if (stack->size == stack->head) {
+        stack->head = stack->size = 0;
+    }
+    return node;
+}
+
+// Remove da pilha os nós com bound >= limit, mantendo a ordem dos demais
+static int stack_prune(NodeStack* stack, NodePool* pool, double limit) {
+    int kept = stack->head;
+    for (int i = stack->head; i < stack->size; i++) {
+        if (stack->data[i]->bound < limit) {
+            stack->data[kept++] = stack->data[i];
+        } else {
+            node_pool_free(pool, stack->data[i]);
+        }
+    }
+    int pruned = stack->size - kept;
+    stack->size = kept;
+    if (stack->size == stack->head) {
+        stack->head = stack->size = 0;
+    }
+    return pruned;
+}
+
+// Libera a pilha (os nós pertencem ao pool)
+static void stack_destroy(NodeStack* stack) {
+    free(stack->data);
+    stack->data = NULL;
+    stack->head = stack->size = stack->capacity = 0;
+}
+
+// Conjunto de nós abertos de uma thread, organizado conforme a estratégia:
+// - heaps: um heap por bound ou, na estratégia cíclica, um heap por nível
+// - stack: nós a expandir em profundidade (busca em profundidade, mergulhos
+//   e nós gerados depois que o limite de nós abertos foi atingido)
+// A pilha tem prioridade na seleção, o que faz cada mergulho ir até o fim
+typedef struct {
+    NodeHeap* heaps;    // Heaps por bound
+    int num_heaps;      // 1, ou n na estratégia cíclica
+    int cursor;         // Próximo nível a visitar (estratégia cíclica)
+    NodeStack stack;    // Nós em profundidade
+    int size;           // Total de nós abertos
+    int peak;           // Pico de nós abertos
+} Frontier;
+
+// Inicializa conjunto vazio com num_heaps heaps
+static void frontier_init(Frontier* f, int num_heaps) {
+    f->num_heaps = num_heaps;
+    f->heaps = (NodeHeap*)malloc(num_heaps * sizeof(NodeHeap));
+    for (int i = 0; i < num_heaps; i++) {
+        heap_init(&f->heaps[i]);
+    }
+    f->cursor = 0;
+    stack_init(&f->stack);
+    f->size = 0;
+    f->peak = 0;
+}
+
+// Insere nó; em profundidade vai para a pilha, senão para o heap do seu nível
+static int frontier_push(Frontier* f, Node* node, int depth_first) {
+    int ok;
+    if (depth_first) {
+        ok = stack_push(&f->stack, node);
     } else {
-        base_name = nome_arquivo;
+        ok = heap_push(&f->heaps[f->num_heaps > 1 ? node->level : 0], node);
     }
-    
-    // Remove a extensão .txt se existir
-    char instance_name[256];
-    strncpy(instance_name, base_name, sizeof(instance_name) - 1);
-    instance_name[sizeof(instance_name) - 1] = '\0';
-    char* dot = strrchr(instance_name, '.');
-    if (dot) {
-        *dot = '\0';
+    if (ok && ++f->size > f->peak) {
+        f->peak = f->size;
     }
-    
+    return ok;
+}
+
+// Seleciona o próximo nó do dono: topo da pilha se houver, senão o menor
+// bound (do próximo nível não vazio, na estratégia cíclica).
+// from_stack indica de onde o nó veio
+static Node* frontier_pop(Frontier* f, int* from_stack) {
+    Node* node = stack_pop(&f->stack);
+    *from_stack = node != NULL;
+    for (int t = 0; !node && t < f->num_heaps; t++) {
+        int level = (f->cursor + t) % f->num_heaps;
+        node = heap_pop(&f->heaps[level]);
+        if (node) {
+            f->cursor = level + 1;
+        }
+    }
+    if (node) {
+        f->size--;
+    }
+    return node;
+}
+
+// Seleciona o nó a ser roubado: o de menor bound entre os heaps ou, se só
+// restar a pilha, o nó mais raso dela
+static Node* frontier_steal(Frontier* f) {
+    NodeHeap* best = NULL;
+    for (int i = 0; i < f->num_heaps; i++) {
+        NodeHeap* heap = &f->heaps[i];
+        if (heap->size > 0 && (!best || heap->data[0].bound < best->data[0].bound)) {
+            best = heap;
+        }
+    }
+    Node* node = best ? heap_pop(best) : stack_take_bottom(&f->stack);
+    if (node) {
+        f->size--;
+    }
+    return node;
+}
+
+// Remove todos os nós com bound >= limit; retorna o número de nós podados
+static int frontier_prune(Frontier* f, NodePool* pool, double limit) {
+    int pruned = stack_prune(&f->stack, pool, limit);
+    for (int i = 0; i < f->num_heaps; i++) {
+        pruned += heap_prune(&f->heaps[i], pool, limit);
+    }
+    f->size -= pruned;
+    return pruned;
+}
+
+// Menor bound entre os nós do conjunto (DBL_MAX se vazio): o topo de cada
+// heap e todos os nós da pilha, que não é ordenada por bound
+static double frontier_min_bound(const Frontier* f) {
+    double bound = DBL_MAX;
+    for (int i = 0; i < f->num_heaps; i++) {
+        if (f->heaps[i].size > 0 && f->heaps[i].data[0].bound < bound) {
+            bound = f->heaps[i].data[0].bound;
+        }
+    }
+    for (int i = f->stack.head; i < f->stack.size; i++) {
+        if (f->stack.data[i]->bound < bound) {
+            bound = f->stack.data[i]->bound;
+        }
+    }
+    return bound;
+}
+
+// Libera o conjunto (os nós pertencem ao pool)
+static void frontier_destroy(Frontier* f) {
+    for (int i = 0; i < f->num_heaps; i++) {
+        heap_destroy(&f->heaps[i]);
+    }
+    free(f->heaps);
+    stack_destroy(&f->stack);
+}
+
+// Tabela de dominância: dois caminhos parciais com as mesmas cidades
+// visitadas e a mesma última cidade têm o mesmo subproblema restante (o
+// tempo acumulado também é o mesmo), então o mais caro não precisa ser
+// expandido. A tabela guarda o menor custo de prefixo conhecido por estado
+// (visitadas, última cidade), identificado pelo hash Zobrist: o XOR de um
+// número aleatório por cidade visitada com um por última cidade, atualizado
+// com um XOR a cada filho. Dois estados com o mesmo hash de 64 bits são
+// tratados como iguais.
+//
+// A memória é fixa (--dominance-mb): buckets de DOMINANCE_BUCKET_SIZE
+// entradas, e com o bucket cheio o novo estado substitui a entrada mais
+// profunda, que protege a menor subárvore. Os buckets são compartilhados
+// entre as threads, protegidos por locks listrados
+#define DOMINANCE_BUCKET_SIZE 4
+#define DOMINANCE_LOCKS 256
+
+// Só há caminhos alternativos para o mesmo estado a partir de 3 cidades
+// além de KingsLanding
+#define DOMINANCE_MIN_LEVEL 3
+
+typedef struct {
+    uint64_t key;       // Hash do estado (0 = entrada vazia)
+    double cost;        // Menor custo de prefixo conhecido
+    int level;          // Profundidade do estado
+} DominanceEntry;
+
+typedef struct {
+    DominanceEntry entries[DOMINANCE_BUCKET_SIZE];
+} DominanceBucket;
+
+typedef struct {
+    DominanceBucket* buckets;
+    size_t mask;                // Número de buckets - 1 (potência de 2)
+    uint64_t* zobrist_city;     // Número por cidade visitada
+    uint64_t* zobrist_last;     // Número por última cidade
+    int shared;                 // Mais de uma thread: usa os locks
+    pthread_mutex_t locks[DOMINANCE_LOCKS];
+} DominanceTable;
+
+// Gerador splitmix64 dos números Zobrist (sempre os mesmos)
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// Cria tabela com até mb megabytes para n cidades (NULL se mb <= 0 ou sem memória)
+static DominanceTable* dominance_create(int n, int mb, int shared) {
+    if (mb <= 0) {
+        return NULL;
+    }
+    size_t num_buckets = 1;
+    while (2 * num_buckets * sizeof(DominanceBucket) <= (size_t)mb * 1048576) {
+        num_buckets *= 2;
+    }
+    DominanceTable* table = (DominanceTable*)malloc(sizeof(DominanceTable));
+    if (!table) {
+        return NULL;
+    }
+    // calloc: as páginas só ocupam memória quando usadas
+    table->buckets = (DominanceBucket*)calloc(num_buckets, sizeof(DominanceBucket));
+    table->zobrist_city = (uint64_t*)malloc(n * sizeof(uint64_t));
+    table->zobrist_last = (uint64_t*)malloc(n * sizeof(uint64_t));
+    if (!table->buckets || !table->zobrist_city || !table->zobrist_last) {
+        free(table->buckets);
+        free(table->zobrist_city);
+        free(table->zobrist_last);
+        free(table);
+        return NULL;
+    }
+    table->mask = num_buckets - 1;
+    uint64_t state = 0x5eed5eedull;
+    for (int i = 0; i < n; i++) {
+        table->zobrist_city[i] = splitmix64(&state);
+        table->zobrist_last[i] = splitmix64(&state);
+    }
+    table->shared = shared;
+    for (int i = 0; i < DOMINANCE_LOCKS; i++) {
+        pthread_mutex_init(&table->locks[i], NULL);
+    }
+    return table;
+}
+
+static void dominance_free(DominanceTable* table) {
+    if (!table) return;
+    for (int i = 0; i < DOMINANCE_LOCKS; i++) {
+        pthread_mutex_destroy(&table->locks[i]);
+    }
+    free(table->buckets);
+    free(table->zobrist_city);
+    free(table->zobrist_last);
+    free(table);
+}
+
+// Memória da tabela em MB
+static double dominance_mb(const DominanceTable* table) {
+    return (table->mask + 1) * sizeof(DominanceBucket) / 1048576.0;
+}
+
+// Chave do estado: hash das visitadas com a última cidade (nunca 0)
+static inline uint64_t dominance_key(const DominanceTable* table, uint64_t zobrist, int last) {
+    return (zobrist ^ table->zobrist_last[last]) | 1;
+}
+
+static inline void dominance_lock(DominanceTable* table, size_t index) {
+    if (table->shared) {
+        pthread_mutex_lock(&table->locks[index & (DOMINANCE_LOCKS - 1)]);
+    }
+}
+
+static inline void dominance_unlock(DominanceTable* table, size_t index) {
+    if (table->shared) {
+        pthread_mutex_unlock(&table->locks[index & (DOMINANCE_LOCKS - 1)]);
+    }
+}
+
+// Resultado de dominance_insert
+typedef enum {
+    DOMINANCE_DOMINATED,    // Já há prefixo de custo menor ou igual
+    DOMINANCE_STORED,       // Estado gravado em entrada vazia ou atualizado
+    DOMINANCE_REPLACED      // Estado gravado no lugar de outro
+} DominanceResult;
+
+// Registra o prefixo de custo cost do estado key, a não ser que ele seja
+// dominado. As entradas nunca são apagadas: a primeira vazia encerra o bucket
+static DominanceResult dominance_insert(DominanceTable* table, uint64_t key,
+                                        double cost, int level) {
+    size_t index = key & table->mask;
+    DominanceEntry* entries = table->buckets[index].entries;
+    DominanceEntry* victim = &entries[0];
+    DominanceResult result = DOMINANCE_REPLACED;
+    dominance_lock(table, index);
+    for (int i = 0; i < DOMINANCE_BUCKET_SIZE; i++) {
+        if (entries[i].key == key) {
+            if (entries[i].cost <= cost) {
+                dominance_unlock(table, index);
+                return DOMINANCE_DOMINATED;
+            }
+            victim = &entries[i];
+            result = DOMINANCE_STORED;
+            break;
+        }
+        if (entries[i].key == 0) {
+            victim = &entries[i];
+            result = DOMINANCE_STORED;
+            break;
+        }
+        if (entries[i].level > victim->level) {
+            victim = &entries[i];
+        }
+    }
+    victim->key = key;
+    victim->cost = cost;
+    victim->level = level;
+    dominance_unlock(table, index);
+    return result;
+}
+
+// Indica se um prefixo estritamente mais barato do estado foi registrado
+// depois que o nó foi criado
+static int dominance_superseded(DominanceTable* table, uint64_t key, double cost) {
+    size_t index = key & table->mask;
+    const DominanceEntry* entries = table->buckets[index].entries;
+    int superseded = 0;
+    dominance_lock(table, index);
+    for (int i = 0; i < DOMINANCE_BUCKET_SIZE; i++) {
+        if (entries[i].key == key) {
+            superseded = entries[i].cost < cost;
+            break;
+        }
+    }
+    dominance_unlock(table, index);
+    return superseded;
+}
+
+// Candidato da expansão: cidade e custo da aresta a partir da cidade atual
+typedef struct {
+    int city;
+    double cost;
+} CityScore;
+
+struct BBSearch;
+
+// Estado de uma thread da busca. Cada thread expande nós do próprio conjunto
+// de abertos e aloca filhos do próprio pool; o conjunto é protegido por lock
+// porque threads sem trabalho roubam dele os nós de menor bound
+typedef struct {
+    int id;
+    struct BBSearch* search;
+    pthread_t thread;
+    pthread_mutex_t lock;       // Protege frontier (o pool só é usado pelo dono)
+    Frontier frontier;          // Nós abertos desta thread
+    NodePool pool;              // Nós alocados por esta thread
+    HKWorkspace* hk_ws;         // Área de trabalho de Held-Karp (NULL se desligado)
+    BoundTable table;           // Tabela de bounds dos filhos
+    CityScore* candidates;      // Candidatos da expansão
+    Node** children;            // Filhos gerados, inseridos em lote
+    double pruned_at;           // Incumbente usada na última poda dos abertos
+    double expanding;           // Bound do nó em expansão (DBL_MAX se nenhum; protegido por lock)
+    double dropped_bound;       // Menor bound dos nós descartados sem poda (protegido por lock)
+    int diving;                 // Mergulho em profundidade em andamento
+    long long heap_pops;        // Nós retirados dos heaps (agenda os mergulhos)
+    unsigned int rng;           // Escolha da thread vítima do roubo
+    long long nodes_explored;
+    long long nodes_pruned;
+    long long nodes_stolen;
+    long long nodes_dominated;  // Descartados pela tabela de dominância
+    long long dominance_stored; // Estados gravados na tabela
+    long long dominance_replaced; // Gravações que substituíram outro estado
+    int num_improvements;
+} BBWorker;
+
+// Estado compartilhado entre as threads
+typedef struct BBSearch {
+    const Instance* inst;
+    FILE* log;                      // Log da busca (log_file é local a cada thread)
+    Portfolio* portfolio;           // Portfólio da busca (NULL fora dele)
+    Telemetry* telemetry;           // Evolução da incumbente, fases e contadores
+    Solution* best_sol;             // Rota incumbente (protegida por incumbent_lock)
+    pthread_mutex_t incumbent_lock;
+    _Atomic double incumbent;       // Custo da incumbente, lido sem lock na poda
+    atomic_long pending;            // Nós abertos ou em expansão em todas as threads
+    atomic_llong explored;          // Nós explorados, somados a cada BB_CLOCK_STRIDE (progresso)
+    _Atomic double next_report;     // Tempo do próximo registro de progresso
+    _Atomic double global_bound;    // Limite inferior global (ver refresh_global_bound)
+    _Atomic double next_bound;      // Tempo da próxima atualização de global_bound
+    atomic_int stop;                // Motivo da parada antes de esgotar a árvore (StopReason)
+    long max_open;                  // Acima deste total de abertos, só profundidade
+    DominanceTable* dominance;      // Tabela de dominância (NULL se desligada)
+    struct timespec start_time;
+    BBWorker* workers;
+    int num_workers;
+} BBSearch;
+
+// Nós expandidos por uma thread entre duas leituras do relógio (potência de 2)
+#define BB_CLOCK_STRIDE 64
+
+// Intervalo (s) entre duas atualizações do limite inferior global
+#define BB_BOUND_INTERVAL 0.5
+
+// Tolerância (%) do gap: o Held-Karp é calculado em float e fica a ~1e-7 da
+// incumbente quando a prova já está completa
+#define BB_GAP_TOL 1e-4
+
+// Custo da incumbente atual (DBL_MAX se ainda não há)
+static inline double search_incumbent(BBSearch* search) {
+    return atomic_load_explicit(&search->incumbent, memory_order_relaxed);
+}
+
+// Segundos desde o início da busca
+static double search_elapsed(const BBSearch* search) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - search->start_time.tv_sec) +
+           (now.tv_nsec - search->start_time.tv_nsec) / 1e9;
+}
+
+// Gap (%) da incumbente sobre o limite inferior global (100 sem incumbente)
+static double search_gap(BBSearch* search) {
+    double incumbent = search_incumbent(search);
+    if (incumbent >= DBL_MAX || incumbent <= 0.0) {
+        return 100.0;
+    }
+    double gap = (incumbent - atomic_load(&search->global_bound)) / incumbent * 100.0;
+    return gap < 0.0 ? 0.0 : gap;
+}
+
+// Encerra a busca pelo motivo indicado (só o primeiro motivo é registrado)
+static void search_stop(BBSearch* search, StopReason reason) {
+    int running = STOP_NONE;
+    if (atomic_compare_exchange_strong(&search->stop, &running, reason)) {
+        write_log("\nBusca encerrada: %s (%.2f s)\n", stop_reason_text(reason),
+                  search_elapsed(search));
+    }
+}
+
+// Menor bound entre todos os nós abertos, em expansão ou descartados sem
+// poda, limitado pela incumbente. Os locks de todas as threads são tomados
+// juntos: um nó roubado sai do conjunto da vítima e entra em expanding do
+// ladrão sob o lock da vítima, então nenhum nó escapa da leitura
+static double search_open_bound(BBSearch* search) {
+    for (int t = 0; t < search->num_workers; t++) {
+        pthread_mutex_lock(&search->workers[t].lock);
+    }
+    double bound = search_incumbent(search);
+    for (int t = 0; t < search->num_workers; t++) {
+        BBWorker* w = &search->workers[t];
+        double open = frontier_min_bound(&w->frontier);
+        if (open < bound) bound = open;
+        if (w->expanding < bound) bound = w->expanding;
+        if (w->dropped_bound < bound) bound = w->dropped_bound;
+    }
+    for (int t = search->num_workers - 1; t >= 0; t--) {
+        pthread_mutex_unlock(&search->workers[t].lock);
+    }
+    return bound;
+}
+
+// A cada BB_BOUND_INTERVAL segundos atualiza o limite inferior global: o
+// maior entre o limite da raiz e o menor bound dos nós ainda abertos. Ele
+// vai para a telemetria e para o portfólio, e com ele a busca para no gap
+// alvo ou no limite de memória
+static void refresh_global_bound(BBSearch* search, double elapsed) {
+    double due = atomic_load_explicit(&search->next_bound, memory_order_relaxed);
+    if (elapsed < due ||
+        !atomic_compare_exchange_strong(&search->next_bound, &due, elapsed + BB_BOUND_INTERVAL)) {
+        return;
+    }
+    double bound = search_open_bound(search);
+    double previous = atomic_load(&search->global_bound);
+    while (bound > previous &&
+           !atomic_compare_exchange_weak(&search->global_bound, &previous, bound)) {
+    }
+    if (bound > previous) {
+        telemetry_point(search->telemetry, DBL_MAX, bound);
+        portfolio_bound(bound);
+    }
+    if (search_incumbent(search) < DBL_MAX && search_gap(search) <= target_gap(0.0) + BB_GAP_TOL) {
+        search_stop(search, STOP_GAP);
+    } else if (memory_limit_reached()) {
+        search_stop(search, STOP_MEMORY);
+    }
+}
+
+// Registra o progresso a cada config.progress_interval segundos. Entre as
+// threads que passam do horário, só a que avança next_report registra
+static void report_progress(BBSearch* search, double elapsed) {
+    double due = atomic_load_explicit(&search->next_report, memory_order_relaxed);
+    if (elapsed < due || !log_enabled(LOG_INFO)) {
+        return;
+    }
+    double next = elapsed + config.progress_interval;
+    if (!atomic_compare_exchange_strong(&search->next_report, &due, next)) {
+        return;
+    }
+    telemetry_point(search->telemetry, DBL_MAX, -DBL_MAX);
+    write_log("\nProgresso:\n");
+    write_log("Tempo: %.2f s\n", elapsed);
+    write_log("Nós explorados: %lld\n",
+              atomic_load_explicit(&search->explored, memory_order_relaxed));
+    write_log("Nós ativos: %ld\n",
+              atomic_load_explicit(&search->pending, memory_order_relaxed));
+    write_log("Melhor custo: %.2f\n", search_incumbent(search));
+    write_log("Limite inferior: %.2f\n", atomic_load(&search->global_bound));
+    write_log("Gap atual: %.2f%%\n", search_gap(search));
+}
+
+// Atualiza a melhor solução se a rota completa do nó for mais barata.
+// obj_value é o custo total da rota (arestas, retorno e tempos mínimos)
+static int update_incumbent(BBSearch* search, const Node* node, double obj_value) {
+    const Instance* inst = search->inst;
+    if (node->total_time > inst->houses[0].power || obj_value >= search_incumbent(search)) {
+        return 0;
+    }
+
+    // Outra thread pode ter melhorado a incumbente depois da leitura acima
+    pthread_mutex_lock(&search->incumbent_lock);
+    Solution* best_sol = search->best_sol;
+    int improved = obj_value < best_sol->cost;
+    if (improved) {
+        memcpy(best_sol->route, node->path, inst->n * sizeof(int));
+        best_sol->cost = obj_value;
+        best_sol->feasible = 1;
+        best_sol->total_time = node->total_time;
+        atomic_store_explicit(&search->incumbent, obj_value, memory_order_relaxed);
+
+        write_log("\nNova melhor solução BB:\n");
+        write_log("Custo: %.2f\n", obj_value);
+        write_log("Tempo total: %d\n", node->total_time);
+        portfolio_offer(best_sol->route, obj_value);
+        telemetry_point(search->telemetry, obj_value, -DBL_MAX);
+    }
+    pthread_mutex_unlock(&search->incumbent_lock);
+    return improved;
+}
+
+// Adota a rota de outro método do portfólio, se for melhor que a incumbente
+static void adopt_portfolio_route(BBSearch* search) {
+    const Instance* inst = search->inst;
+    pthread_mutex_lock(&search->incumbent_lock);
+    Solution* best_sol = search->best_sol;
+    double cost = best_sol->cost;
+    if (portfolio_fetch(best_sol->route, &cost)) {
+        best_sol->cost = cost;
+        best_sol->feasible = 1;
+        best_sol->total_time = 0;
+        for (int i = 0; i < inst->n; i++) {
+            best_sol->total_time += inst->houses[i].min_time;
+        }
+        atomic_store_explicit(&search->incumbent, cost, memory_order_relaxed);
+        write_log("\nRota do portfólio adotada: %.2f\n", cost);
+        telemetry_point(search->telemetry, cost, -DBL_MAX);
+    }
+    pthread_mutex_unlock(&search->incumbent_lock);
+}
+
+// Poda dos abertos da thread os nós dominados por uma incumbente mais nova
+static void worker_prune(BBWorker* w) {
+    if (portfolio_incumbent() < search_incumbent(w->search)) {
+        adopt_portfolio_route(w->search);
+    }
+    double incumbent = search_incumbent(w->search);
+    if (incumbent >= w->pruned_at) {
+        return;
+    }
+    pthread_mutex_lock(&w->lock);
+    int pruned = frontier_prune(&w->frontier, &w->pool, incumbent);
+    pthread_mutex_unlock(&w->lock);
+    w->pruned_at = incumbent;
+    w->nodes_pruned += pruned;
+    atomic_fetch_sub_explicit(&w->search->pending, pruned, memory_order_relaxed);
+}
+
+// Retira o próximo nó dos abertos da própria thread. Um nó vindo dos heaps
+// inicia um mergulho a cada config.dive_freq seleções (estratégia BB_DIVE)
+static Node* worker_pop(BBWorker* w) {
+    int from_stack;
+    pthread_mutex_lock(&w->lock);
+    Node* node = frontier_pop(&w->frontier, &from_stack);
+    w->expanding = node ? node->bound : DBL_MAX;
+    pthread_mutex_unlock(&w->lock);
+    if (node && !from_stack) {
+        w->diving = config.strategy == BB_DIVE &&
+                    ++w->heap_pops % config.dive_freq == 0;
+    }
+    return node;
+}
+
+// Rouba o nó de menor bound de outra thread, começando por uma vítima
+// aleatória. O nó é copiado para o pool local e o original devolvido ao dono
+static Node* worker_steal(BBWorker* w) {
+    BBSearch* search = w->search;
+    int k = search->num_workers;
+    int start = rand_r(&w->rng) % k;
+
+    for (int t = 0; t < k; t++) {
+        BBWorker* victim = &search->workers[(start + t) % k];
+        if (victim == w) continue;
+
+        pthread_mutex_lock(&victim->lock);
+        Node* node = frontier_steal(&victim->frontier);
+        if (node) {
+            w->expanding = node->bound;
+        }
+        pthread_mutex_unlock(&victim->lock);
+        if (!node) continue;
+
+        Node* copy = node_pool_alloc(&w->pool);
+        if (!copy) {
+            // Sem memória local: o nó volta para a vítima
+            pthread_mutex_lock(&victim->lock);
+            int ok = frontier_push(&victim->frontier, node, 1);
+            if (!ok && node->bound < victim->dropped_bound) {
+                victim->dropped_bound = node->bound;
+            }
+            pthread_mutex_unlock(&victim->lock);
+            if (!ok) {
+                node_pool_free_remote(&victim->pool, node);
+                atomic_fetch_sub_explicit(&search->pending, 1, memory_order_relaxed);
+            }
+            return NULL;
+        }
+        node_copy(&w->pool, copy, node);
+        node_pool_free_remote(&victim->pool, node);
+        w->nodes_stolen++;
+        return copy;
+    }
+    return NULL;
+}
+
+// Expande o nó: gera os filhos que sobrevivem ao bound e os insere nos abertos
+static void worker_expand(BBWorker* w, Node* current) {
+    BBSearch* search = w->search;
+    const Instance* inst = search->inst;
+    int n = inst->n;
+    CityScore* candidates = w->candidates;
+    int num_candidates = 0;
+    int num_children = 0;
+
+    // Calcula custos para todas as cidades não visitadas
+    for (int i = 1; i < n; i++) {
+        if (!current->visited[i]) {
+            int new_time = current->total_time + inst->houses[i].min_time;
+            if (new_time <= inst->houses[0].power) {
+                int prev = current->path[current->level];
+                double edge_cost = inst->cost[prev * n + i];
+                candidates[num_candidates].city = i;
+                candidates[num_candidates].cost = edge_cost;
+                num_candidates++;
+            }
+        }
+    }
+
+    // Ordena candidatos por custo
+    for (int i = 0; i < num_candidates-1; i++) {
+        for (int j = i+1; j < num_candidates; j++) {
+            if (candidates[j].cost < candidates[i].cost) {
+                CityScore temp = candidates[i];
+                candidates[i] = candidates[j];
+                candidates[j] = temp;
+            }
+        }
+    }
+
+    // Tabela das menores saídas do pai: bounds dos filhos em O(1) cada
+    bound_table_build(inst, current, &w->table);
+
+    // Expande nós na ordem de custo
+    for (int i = 0; i < num_candidates; i++) {
+        int city = candidates[i].city;
+        int new_time = current->total_time + inst->houses[city].min_time;
+        double new_cost = current->cost + candidates[i].cost +
+                          inst->houses[city].min_time;
+
+        // O nó só é alocado se não for podado pelo bound
+        double bound;
+        if (current->level + 1 == n-1) {
+            bound = new_cost + inst->cost[city * n];
+        } else {
+            bound = bound_table_child(inst, &w->table, city, new_cost, new_time);
+        }
+        if (bound >= search_incumbent(search)) {
+            w->nodes_pruned++;
+            continue;
+        }
+
+        // Descarta o filho se o mesmo estado já foi alcançado por um prefixo
+        // de custo menor ou igual
+        uint64_t zobrist = 0;
+        if (search->dominance) {
+            zobrist = current->zobrist ^ search->dominance->zobrist_city[city];
+            int level = current->level + 1;
+            if (level >= DOMINANCE_MIN_LEVEL && level < n - 1) {
+                DominanceResult result = dominance_insert(
+                    search->dominance, dominance_key(search->dominance, zobrist, city),
+                    new_cost, level);
+                if (result == DOMINANCE_DOMINATED) {
+                    w->nodes_pruned++;
+                    w->nodes_dominated++;
+                    continue;
+                }
+                w->dominance_stored++;
+                if (result == DOMINANCE_REPLACED) {
+                    w->dominance_replaced++;
+                }
+            }
+        }
+
+        Node* new_node = node_pool_alloc(&w->pool);
+        if (!new_node) {
+            // Sem memória para o filho: a busca para, e o bound do pai (que
+            // limita este filho e os irmãos não gerados) entra no limite final
+            pthread_mutex_lock(&w->lock);
+            if (current->bound < w->dropped_bound) {
+                w->dropped_bound = current->bound;
+            }
+            pthread_mutex_unlock(&w->lock);
+            search_stop(search, STOP_MEMORY);
+            break;
+        }
+        new_node->level = current->level + 1;
+
+        // path e visited são contíguos no bloco: uma única cópia
+        memcpy(new_node->path, current->path, 2 * n * sizeof(int));
+
+        new_node->path[new_node->level] = city;
+        new_node->visited[city] = 1;
+        new_node->total_time = new_time;
+        new_node->cost = new_cost;
+        new_node->bound = bound;
+        new_node->zobrist = zobrist;
+
+        // Rota completa: atualiza a incumbente imediatamente
+        if (new_node->level == n-1) {
+            if (update_incumbent(search, new_node, new_node->bound)) {
+                w->num_improvements++;
+
+                // Poda imediata dos nós abertos dominados pela nova incumbente
+                worker_prune(w);
+            }
+            node_pool_free(&w->pool, new_node);
+            continue;
+        }
+
+        // Limite de Held-Karp nos níveis rasos, aquecido pelas penalidades do pai
+        if (new_node->pi && new_node->level <= config.hk_depth) {
+            memcpy(new_node->pi, current->pi, n * sizeof(double));
+            double hk = calculate_hk_bound(inst, w->hk_ws, new_node, new_node->pi,
+                                           config.hk_node_iter, search_incumbent(search));
+            if (hk > new_node->bound) {
+                new_node->bound = hk;
+            }
+        }
+
+        if (new_node->bound >= search_incumbent(search)) {
+            w->nodes_pruned++;
+            node_pool_free(&w->pool, new_node);
+            continue;
+        }
+        w->children[num_children++] = new_node;
+    }
+
+    if (num_children == 0) {
+        return;
+    }
+
+    // Ordena os filhos por bound decrescente: na pilha o melhor fica no topo
+    Node** children = w->children;
+    for (int i = 1; i < num_children; i++) {
+        Node* child = children[i];
+        int j = i;
+        while (j > 0 && children[j - 1]->bound < child->bound) {
+            children[j] = children[j - 1];
+            j--;
+        }
+        children[j] = child;
+    }
+
+    // Os filhos entram na contagem antes de ficarem visíveis para roubo, para
+    // que nenhuma thread veja a busca vazia enquanto o pai ainda é expandido.
+    // Acima do limite de abertos a thread passa a expandir em profundidade
+    long open = atomic_fetch_add_explicit(&search->pending, num_children,
+                                          memory_order_relaxed) + num_children;
+    int depth_first = config.strategy == BB_DEPTH_FIRST || open > search->max_open;
+    int rejected = 0;
+    pthread_mutex_lock(&w->lock);
+    for (int i = 0; i < num_children; i++) {
+        // Em um mergulho só o melhor filho segue em profundidade
+        int to_stack = depth_first || (w->diving && i == num_children - 1);
+        
+        // Descarta o filho se os abertos não puderem crescer
+        if (!frontier_push(&w->frontier, children[i], to_stack)) {
+            if (children[i]->bound < w->dropped_bound) {
+                w->dropped_bound = children[i]->bound;
+            }
+            node_pool_free(&w->pool, children[i]);
+            rejected++;
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+    if (rejected > 0) {
+        w->nodes_pruned += rejected;
+        atomic_fetch_sub_explicit(&search->pending, rejected, memory_order_relaxed);
+    }
+}
+
+// Laço principal de uma thread: expande os próprios nós abertos, rouba de
+// outras threads quando eles acabam e termina quando não resta nó aberto em nenhuma
+static void* worker_run(void* arg) {
+    BBWorker* w = (BBWorker*)arg;
+    BBSearch* search = w->search;
+    int n = search->inst->n;
+    log_file = search->log;
+    portfolio_attach(search->portfolio, ENGINE_BB);
+
+    while (!atomic_load_explicit(&search->stop, memory_order_relaxed)) {
+        worker_prune(w);
+
+        // Seleciona nó com menor bound
+        Node* current = worker_pop(w);
+        if (!current && search->num_workers > 1) {
+            current = worker_steal(w);
+        }
+        if (!current) {
+            // Nós em expansão em outras threads ainda podem gerar trabalho
+            if (atomic_load_explicit(&search->pending, memory_order_acquire) == 0) {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        // O relógio e os limites da execução só são consultados a cada
+        // BB_CLOCK_STRIDE nós desta thread
+        if ((++w->nodes_explored & (BB_CLOCK_STRIDE - 1)) == 0) {
+            long long explored = atomic_fetch_add_explicit(&search->explored, BB_CLOCK_STRIDE,
+                                                           memory_order_relaxed) + BB_CLOCK_STRIDE;
+            double elapsed = search_elapsed(search);
+            refresh_global_bound(search, elapsed);
+            report_progress(search, elapsed);
+            StopReason reason = limit_reached(elapsed, explored);
+            if (reason != STOP_NONE) {
+                search_stop(search, reason);
+            }
+            // O nó volta aos abertos: conta no limite inferior final
+            if (atomic_load(&search->stop)) {
+                pthread_mutex_lock(&w->lock);
+                if (!frontier_push(&w->frontier, current, 1)) {
+                    if (current->bound < w->dropped_bound) {
+                        w->dropped_bound = current->bound;
+                    }
+                    node_pool_free(&w->pool, current);
+                }
+                pthread_mutex_unlock(&w->lock);
+                break;
+            }
+        }
+
+        // Remoção preguiçosa: nós que ficaram acima da melhor solução
+        // depois de inseridos são descartados apenas quando chegam ao topo
+        if (current->bound >= search_incumbent(search)) {
+            w->nodes_pruned++;
+        }
+        // Um prefixo mais barato do mesmo estado apareceu depois deste nó
+        else if (search->dominance && current->level >= DOMINANCE_MIN_LEVEL &&
+                 dominance_superseded(search->dominance,
+                                      dominance_key(search->dominance, current->zobrist,
+                                                    current->path[current->level]),
+                                      current->cost)) {
+            w->nodes_pruned++;
+            w->nodes_dominated++;
+        }
+        // Se encontrou solução completa (apenas quando n == 1, já que filhos
+        // completos são avaliados no momento da expansão)
+        else if (current->level == n-1) {
+            if (update_incumbent(search, current, current->bound)) {
+                w->num_improvements++;
+            }
+        }
+        // Expande nó
+        else {
+            worker_expand(w, current);
+        }
+
+        node_pool_free(&w->pool, current);
+        atomic_fetch_sub_explicit(&search->pending, 1, memory_order_release);
+    }
+    pthread_mutex_lock(&w->lock);
+    w->expanding = DBL_MAX;
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+// Libera as threads, os nós e a tabela de dominância da busca
+// Inicializa a thread t da busca. Penalidades de Held-Karp só são
+// guardadas nos nós se usadas abaixo da raiz
+static void worker_init(BBWorker* w, BBSearch* search, int t, int n) {
+    w->id = t;
+    w->search = search;
+    pthread_mutex_init(&w->lock, NULL);
+    frontier_init(&w->frontier, config.strategy == BB_CYCLIC ? n : 1);
+    node_pool_init(&w->pool, n, config.hk_depth > 0);
+    w->hk_ws = config.hk_depth >= 0 ? hk_workspace_create(n) : NULL;
+    bound_table_init(&w->table, n);
+    w->candidates = (CityScore*)malloc(n * sizeof(CityScore));
+    w->children = (Node**)malloc(n * sizeof(Node*));
+    w->pruned_at = DBL_MAX;
+    w->expanding = DBL_MAX;
+    w->dropped_bound = DBL_MAX;
+    w->rng = 2654435761u * (t + 1);
+}
+
+static void search_destroy(BBSearch* search) {
+    for (int t = 0; t < search->num_workers; t++) {
+        BBWorker* w = &search->workers[t];
+        free(w->candidates);
+        free(w->children);
+        bound_table_free(&w->table);
+        frontier_destroy(&w->frontier);
+        node_pool_destroy(&w->pool);
+        hk_workspace_free(w->hk_ws);
+        pthread_mutex_destroy(&w->lock);
+    }
+    free(search->workers);
+    dominance_free(search->dominance);
+    pthread_mutex_destroy(&search->incumbent_lock);
+}
+
+// Resolve TSP usando Branch and Bound
+Solution* solve_bb(const Instance* inst, const char* nome_arquivo) {
+    int n = inst->n;
+
+    // Nome base do arquivo, sem o caminho e sem a extensão
+    char instance_name[256];
+    instance_base_name(nome_arquivo, instance_name, sizeof(instance_name));
+
     // Cria nome do arquivo de log
-    char log_filename[256];
-    sprintf(log_filename, "logs/%s_BB.log", instance_name);
+    char log_filename[300];
+    snprintf(log_filename, sizeof(log_filename), "logs/%s_BB.log", instance_name);
     open_log(log_filename);
-    
+
+    // Estado compartilhado da busca
+    BBSearch search;
+    search.inst = inst;
+    search.log = log_file;
+    search.portfolio = portfolio_current();
+    search.telemetry = telemetry_create(instance_name, ENGINE_BB);
+
     // Registra início da execução com mais precisão
-    struct timespec start_time;
-    clock_gettime(CLOCK_MONOTONIC, &start_time);
-    
+    clock_gettime(CLOCK_MONOTONIC, &search.start_time);
+
     // Inicializa melhor solução
     Solution* best_sol = (Solution*)malloc(sizeof(Solution));
     best_sol->route = (int*)malloc(n * sizeof(int));
@@ -148,32 +1449,28 @@ Solution* solve_bb(const Instance* inst, const char* nome_arquivo) {
     best_sol->gap = 100.0;
     best_sol->time = 0.0;
     best_sol->total_time = 0;
+    best_sol->optimal = 0;
+    best_sol->engine = ENGINE_BB;
+    search.best_sol = best_sol;
+    pthread_mutex_init(&search.incumbent_lock, NULL);
+    atomic_init(&search.incumbent, DBL_MAX);
+    atomic_init(&search.pending, 0);
+    atomic_init(&search.explored, 0);
+    atomic_init(&search.next_report, config.progress_interval);
+    atomic_init(&search.global_bound, -DBL_MAX);
+    atomic_init(&search.next_bound, BB_BOUND_INTERVAL);
+    atomic_init(&search.stop, STOP_NONE);
 
-    // Array para armazenar soluções BB
-    BBSolution* bb_solutions = NULL;
-    int num_solutions = 0;
-    int max_solutions = 1000;
-    bb_solutions = (BBSolution*)malloc(max_solutions * sizeof(BBSolution));
-    
     // Calcula bound inicial BB
     double bb_bound = calculate_initial_bound(inst);
-    
+
     write_log("=== Branch and Bound para TSP ===\n");
     write_log("Instância: %s\n", instance_name);
     write_log("Método: BB\n");
     write_log("Número de cidades: %d\n\n", n);
 
-    // Imprime matriz de custos no formato exato do PLI
-    write_log("Matriz de custos (distância * (1 + risco)):\n");
-    for (int i = 0; i < n; i++) {
-        write_log("   ");
-        for (int j = 0; j < n; j++) {
-            double cost = inst->dist[i][j] * (1.0 + inst->risk[i][j]);
-            write_log("%6.2f ", cost);
-        }
-        write_log("\n");
-    }
-    write_log("\n");
+    // Matriz de custos no mesmo formato do PLI (só no nível debug)
+    log_cost_matrix(inst);
 
     // Imprime tempos mínimos exatamente como no PLI
     write_log("Tempos mínimos:\n");
@@ -182,243 +1479,241 @@ Solution* solve_bb(const Instance* inst, const char* nome_arquivo) {
     }
     write_log("\n");
 
-    write_log("=== Execução do algoritmo ===\n");
-    write_log("Resolvendo relaxação linear...\n");
-    write_log("Relaxação linear resolvida. Valor: %.2f\n\n", bb_bound);
-
-    write_log("Resolvendo com parâmetros:\n");
-    write_log("- Tempo limite: 600 segundos\n");
-    write_log("- Gap alvo: 1.00%%\n");
-    write_log("- Presolve: ON\n");
-    write_log("- Cuts: GMI=ON MIR=ON COV=ON CLQ=ON\n\n");
+    // Threads da busca. Cada uma tem pool de nós próprio: um bloco por nó,
+    // reciclado quando o nó é podado
+    search.num_workers = config.threads > 0 ? config.threads : 1;
+    search.workers = (BBWorker*)calloc(search.num_workers, sizeof(BBWorker));
+    for (int t = 0; t < search.num_workers; t++) {
+        worker_init(&search.workers[t], &search, t, n);
+    }
+    BBWorker* main_worker = &search.workers[0];
+    search.max_open = config.max_open_mb > 0 ?
+        (long)(config.max_open_mb * 1048576.0 / main_worker->pool.block_size) : LONG_MAX;
+    HKWorkspace* hk_ws = main_worker->hk_ws;
+    search.dominance = dominance_create(n, config.dominance_mb, search.num_workers > 1);
+    if (!search.dominance && config.dominance_mb > 0) {
+        write_log_at(LOG_ERROR, "Memória insuficiente para a tabela de dominância; "
+                     "busca sem ela\n");
+    }
 
-    write_log("Iniciando resolução MIP...\n");
+    // Rota heurística inicial: a busca já começa com uma incumbente, que
+    // poda desde o primeiro nó e garante resposta viável no tempo limite
+    double heur_cost = DBL_MAX;
+    double heur_time = 0.0;
+    telemetry_phase(search.telemetry, "heuristic");
+    if (config.heuristic && heuristic_tour(inst, best_sol->route, &heur_cost)) {
+        best_sol->cost = heur_cost;
+        best_sol->feasible = 1;
+        for (int i = 0; i < n; i++) {
+            best_sol->total_time += inst->houses[i].min_time;
+        }
+        atomic_store(&search.incumbent, heur_cost);
+        portfolio_offer(best_sol->route, heur_cost);
+        telemetry_point(search.telemetry, heur_cost, -DBL_MAX);
+        struct timespec heur_end;
+        clock_gettime(CLOCK_MONOTONIC, &heur_end);
+        heur_time = (heur_end.tv_sec - search.start_time.tv_sec) +
+                    (heur_end.tv_nsec - search.start_time.tv_nsec) / 1e9;
+    }
 
     // Inicializa nó raiz
-    Node* root = (Node*)malloc(sizeof(Node));
+    Node* root = node_pool_alloc(&main_worker->pool);
+    if (!root) {
+        // Sem busca: fica a rota heurística, se houver, com o gap do bound inicial
+        write_log_at(LOG_ERROR, "Memória insuficiente para o nó raiz\n");
+        write_log("Parada: %s\n", stop_reason_text(STOP_MEMORY));
+        if (best_sol->feasible) {
+            best_sol->gap = ((best_sol->cost - bb_bound) / best_sol->cost) * 100.0;
+            if (best_sol->gap < 0) best_sol->gap = 0.0;
+            write_log("Custo: %.2f\n", best_sol->cost);
+            write_log("Gap: %.2f%%\n", best_sol->gap);
+        }
+        telemetry_point(search.telemetry, DBL_MAX, bb_bound);
+        best_sol->time = search_elapsed(&search);
+        telemetry_finish(search.telemetry, best_sol);
+        search_destroy(&search);
+        close_log();
+        return best_sol;
+    }
     root->level = 0;
-    root->path = (int*)malloc(n * sizeof(int));
-    root->visited = (int*)calloc(n, sizeof(int));
     memset(root->path, -1, n * sizeof(int));
-    root->cost = 0;
+    memset(root->visited, 0, n * sizeof(int));
+    root->cost = inst->houses[0].min_time;
     root->total_time = inst->houses[0].min_time;
     root->path[0] = 0;
     root->visited[0] = 1;
+    root->zobrist = search.dominance ? search.dominance->zobrist_city[0] : 0;
 
     // Calcula o bound inicial para o nó raiz
+    telemetry_phase(search.telemetry, "root_bound");
     root->bound = calculate_bound(inst, root);
 
-    // Lista de nós ativos
-    Node** active = (Node**)malloc(1000000 * sizeof(Node*));
-    int num_active = 1;
-    active[0] = root;
-    
-    int nodes_explored = 0;
-    
-    // Branch and Bound
-    while (num_active > 0) {
-        nodes_explored++;
-        
-        // Verifica tempo atual
-        struct timespec current_time;
-        clock_gettime(CLOCK_MONOTONIC, &current_time);
-        double elapsed = (current_time.tv_sec - start_time.tv_sec) + 
-                        (current_time.tv_nsec - start_time.tv_nsec) / 1e9;
-        
-        // Log periódico
-        if ((nodes_explored % 1000) == 0) {
-            write_log("\nProgresso:\n");
-            write_log("Tempo: %.2f s\n", elapsed);
-            write_log("Nós explorados: %d\n", nodes_explored);
-            write_log("Nós ativos: %d\n", num_active);
-            write_log("Melhor custo: %.2f\n", best_sol->cost);
-            write_log("Gap atual: %.2f%%\n", best_sol->gap);
+    // Limite de Held-Karp na raiz (penalidades partem de zero)
+    double hk_root = -DBL_MAX;
+    if (hk_ws && root->bound < DBL_MAX) {
+        double* root_pi = root->pi ? root->pi : (double*)malloc(n * sizeof(double));
+        memset(root_pi, 0, n * sizeof(double));
+        hk_root = calculate_hk_bound(inst, hk_ws, root, root_pi,
+                                     config.hk_root_iter, DBL_MAX);
+        if (hk_root > root->bound) {
+            root->bound = hk_root;
         }
-        
-        // Verifica tempo limite
-        if (elapsed >= 600.0) {
-            write_log("\nTempo limite excedido (600s)!\n");
-            break;
+        if (root_pi != root->pi) {
+            free(root_pi);
         }
+    }
+    if (root->bound < DBL_MAX && root->bound > bb_bound) {
+        bb_bound = root->bound;
+    }
+    telemetry_point(search.telemetry, DBL_MAX, bb_bound);
+    atomic_store(&search.global_bound, bb_bound);
 
-        // Seleciona nó com menor bound
-        int best_idx = 0;
-        for (int i = 1; i < num_active; i++) {
-            if (active[i]->bound < active[best_idx]->bound)
-                best_idx = i;
-        }
-        
-        Node* current = active[best_idx];
-        active[best_idx] = active[--num_active];
-
-        // Se o bound do nó atual é maior que a melhor solução, poda
-        if (current->bound >= best_sol->cost) {
-            free(current->path);
-            free(current->visited);
-            free(current);
-            continue;
-        }
+    // Limite da raiz (o mesmo usado na poda) para o portfólio
+    if (root->bound < DBL_MAX) {
+        portfolio_bound(root->bound);
+    }
 
-        // Se encontrou solução completa
-        if (current->level == n-1) {
-            int last = current->path[current->level];
-            double return_cost = inst->dist[last][0] * (1.0 + inst->risk[last][0]);
-            double obj_value = current->cost + return_cost;
-            int final_time = current->total_time + inst->houses[0].min_time;
+    write_log("=== Execução do algoritmo ===\n");
+    if (heur_cost < DBL_MAX) {
+        write_log("Solução heurística inicial (2-opt/Or-opt): %.2f em %.3f s\n",
+                  heur_cost, heur_time);
+    }
+    if (hk_ws) {
+        write_log("Limite de Held-Karp (1-árvore, %d iterações): %.2f\n",
+                  config.hk_root_iter, hk_root);
+    }
+    write_log("Limite inferior da raiz: %.2f\n\n", bb_bound);
 
-            if (final_time <= inst->houses[0].power) {
-                if (num_solutions >= max_solutions) {
-                    max_solutions *= 2;
-                    bb_solutions = (BBSolution*)realloc(bb_solutions, 
-                                 max_solutions * sizeof(BBSolution));
-                }
-                
-                bb_solutions[num_solutions].route = (int*)malloc(n * sizeof(int));
-                memcpy(bb_solutions[num_solutions].route, current->path, n * sizeof(int));
-                bb_solutions[num_solutions].cost = obj_value;
-                bb_solutions[num_solutions].total_time = final_time;
-                
-                write_log("\nSolução BB encontrada #%d:\n", num_solutions + 1);
-                write_log("Custo: %.2f\n", obj_value);
-                write_log("Tempo total: %d\n", final_time);
-                
-                num_solutions++;
-            }
-            
-            // Libera nó atual e continua explorando
-            free(current->path);
-            free(current->visited);
-            free(current);
-            continue;
-        }
-        
-        // Expande nó
-        else {
-            // Ordena cidades candidatas por custo
-            typedef struct {
-                int city;
-                double cost;
-            } CityScore;
-            
-            CityScore* candidates = malloc((n-1) * sizeof(CityScore));
-            int num_candidates = 0;
-            
-            // Calcula custos para todas as cidades não visitadas
-            for (int i = 1; i < n; i++) {
-                if (!current->visited[i]) {
-                    int new_time = current->total_time + inst->houses[i].min_time;
-                    if (new_time <= inst->houses[0].power) {
-                        int prev = current->path[current->level];
-                        double edge_cost = inst->dist[prev][i] * (1.0 + inst->risk[prev][i]);
-                        candidates[num_candidates].city = i;
-                        candidates[num_candidates].cost = edge_cost;
-                        num_candidates++;
-                    }
-                }
-            }
-            
-            // Ordena candidatos por custo
-            for (int i = 0; i < num_candidates-1; i++) {
-                for (int j = i+1; j < num_candidates; j++) {
-                    if (candidates[j].cost < candidates[i].cost) {
-                        CityScore temp = candidates[i];
-                        candidates[i] = candidates[j];
-                        candidates[j] = temp;
-                    }
-                }
-            }
-            
-            // Expande nós na ordem de custo
-            for (int i = 0; i < num_candidates; i++) {
-                int city = candidates[i].city;
-                int new_time = current->total_time + inst->houses[city].min_time;
-                
-                Node* new_node = (Node*)malloc(sizeof(Node));
-                new_node->level = current->level + 1;
-                new_node->path = (int*)malloc(n * sizeof(int));
-                new_node->visited = (int*)malloc(n * sizeof(int));
-                
-                memcpy(new_node->path, current->path, n * sizeof(int));
-                memcpy(new_node->visited, current->visited, n * sizeof(int));
-                
-                new_node->path[new_node->level] = city;
-                new_node->visited[city] = 1;
-                new_node->total_time = new_time;
-                
-                int prev = current->path[current->level];
-                double edge_cost = inst->dist[prev][city] * (1.0 + inst->risk[prev][city]);
-                new_node->cost = current->cost + edge_cost;
-                new_node->bound = calculate_bound(inst, new_node);
-                
-                if (new_node->bound < best_sol->cost) {
-                    active[num_active++] = new_node;
-                } else {
-                    free(new_node->path);
-                    free(new_node->visited);
-                    free(new_node);
-                }
-            }
-            
-            free(candidates);
-        }
-        
-        free(current->path);
-        free(current->visited);
-        free(current);
+    write_log("Resolvendo com parâmetros:\n");
+    write_log("- Tempo limite: %.0f segundos\n", config.time_limit);
+    if (config.node_limit > 0) {
+        write_log("- Limite de nós: %lld\n", config.node_limit);
     }
-    
-    // Seleciona melhor solução BB
-    if (num_solutions > 0) {
-        write_log("\nEncontradas %d soluções BB\n", num_solutions);
-        
-        int best_solution_idx = 0;
-        for (int i = 1; i < num_solutions; i++) {
-            if (bb_solutions[i].cost < bb_solutions[best_solution_idx].cost) {
-                best_solution_idx = i;
-            }
-        }
-        
-        // Atualiza melhor solução
-        memcpy(best_sol->route, bb_solutions[best_solution_idx].route, n * sizeof(int));
-        best_sol->cost = bb_solutions[best_solution_idx].cost;
-        best_sol->feasible = 1;
-        best_sol->total_time = bb_solutions[best_solution_idx].total_time;
-        
-        // Calcula gap
+    if (config.mem_limit_mb > 0) {
+        write_log("- Limite de memória: %d MB\n", config.mem_limit_mb);
+    }
+    write_log("- Gap alvo: %.2f%%\n", target_gap(0.0));
+    write_log("- Held-Karp até profundidade: %d\n", config.hk_depth);
+    write_log("- Kernels SIMD: %s\n", simd.name);
+    write_log("- Threads: %d\n", search.num_workers);
+    write_log("- Estratégia: %s\n", strategy_name(config.strategy));
+    if (config.max_open_mb > 0) {
+        write_log("- Limite de nós abertos: %ld (%d MB)\n", search.max_open, config.max_open_mb);
+    }
+    if (search.dominance) {
+        write_log("- Tabela de dominância: %zu estados (%.0f MB)\n",
+                  (search.dominance->mask + 1) * DOMINANCE_BUCKET_SIZE,
+                  dominance_mb(search.dominance));
+    }
+    write_log("\nIniciando a busca...\n");
+
+    // A raiz começa na primeira thread; as demais roubam dela
+    frontier_push(&main_worker->frontier, root, config.strategy == BB_DEPTH_FIRST);
+    atomic_store(&search.pending, 1);
+
+    // Branch and Bound: a thread principal também participa da busca
+    for (int t = 1; t < search.num_workers; t++) {
+        pthread_create(&search.workers[t].thread, NULL, worker_run, &search.workers[t]);
+    }
+    telemetry_phase(search.telemetry, "search");
+    worker_run(main_worker);
+    for (int t = 1; t < search.num_workers; t++) {
+        pthread_join(search.workers[t].thread, NULL);
+    }
+    StopReason stop = (StopReason)atomic_load(&search.stop);
+
+    // Limite inferior final: o menor bound dos nós que ficaram abertos. Com
+    // a árvore esgotada não resta nenhum e ele é a própria incumbente
+    double open_bound = search_open_bound(&search);
+    if (open_bound < DBL_MAX && open_bound > bb_bound) {
+        bb_bound = open_bound;
+    }
+    if (atomic_load(&search.global_bound) > bb_bound) {
+        bb_bound = atomic_load(&search.global_bound);
+    }
+    if (best_sol->feasible && bb_bound >= best_sol->cost * (1.0 - BB_GAP_TOL / 100.0)) {
+        best_sol->optimal = 1;
+        bb_bound = best_sol->cost;
+        portfolio_bound(best_sol->cost);
+    }
+
+    // Totais das threads
+    long long nodes_explored = 0;
+    long long nodes_pruned = 0;
+    long long nodes_dominated = 0;
+    long long dominance_stored = 0;
+    long long dominance_replaced = 0;
+    int num_improvements = 0;
+    int peak_active = 0;
+    size_t peak_live = 0;
+    size_t num_slabs = 0;
+    size_t slab_bytes = main_worker->pool.slab_header +
+                        NODE_POOL_SLAB_NODES * main_worker->pool.block_size;
+    for (int t = 0; t < search.num_workers; t++) {
+        BBWorker* w = &search.workers[t];
+        nodes_explored += w->nodes_explored;
+        nodes_pruned += w->nodes_pruned;
+        nodes_dominated += w->nodes_dominated;
+        dominance_stored += w->dominance_stored;
+        dominance_replaced += w->dominance_replaced;
+        num_improvements += w->num_improvements;
+        peak_active += w->frontier.peak;
+        peak_live += w->pool.peak_live;
+        num_slabs += w->pool.num_slabs;
+    }
+
+    // Calcula gap da melhor solução encontrada
+    if (best_sol->feasible) {
+        write_log("\nMelhorias da incumbente: %d\n", num_improvements);
+
         if (bb_bound > 0) {
             best_sol->gap = ((best_sol->cost - bb_bound) / best_sol->cost) * 100.0;
             if (best_sol->gap < 0) best_sol->gap = 0.0;
         } else {
             best_sol->gap = 0.0;
         }
-
-        write_log("\nMelhor solução selecionada:\n");
-        write_log("Índice: %d de %d\n", best_solution_idx + 1, num_solutions);
-        write_log("Custo: %.2f\n", best_sol->cost);
-        write_log("Gap: %.2f%%\n", best_sol->gap);
-    }
-
-    // Libera memória das soluções BB
-    for (int i = 0; i < num_solutions; i++) {
-        free(bb_solutions[i].route);
     }
-    free(bb_solutions);
 
     // Registra tempo final
     struct timespec end_time;
     clock_gettime(CLOCK_MONOTONIC, &end_time);
-    best_sol->time = (end_time.tv_sec - start_time.tv_sec) + 
-                     (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
-    
-    // Resultados finais no formato EXATO do PLI para os scripts funcionarem
-    write_log("\nSolução encontrada:\n");
-    write_log("  Lower bound (relaxação): %.2f\n", bb_bound);
-    write_log("  Upper bound (inteira): %.2f\n", best_sol->cost);
-    write_log("  Gap: %.2f%%\n", best_sol->gap);
-    write_log("\n");
+    best_sol->time = (end_time.tv_sec - search.start_time.tv_sec) +
+                     (end_time.tv_nsec - search.start_time.tv_nsec) / 1e9;
+
+    // Estatísticas da busca e do pool de nós
+    write_log("\nEstatísticas da busca:\n");
+    write_log("Nós explorados: %lld\n", nodes_explored);
+    write_log("Nós podados: %lld\n", nodes_pruned);
+    if (search.dominance) {
+        write_log("Nós dominados: %lld\n", nodes_dominated);
+        write_log("Estados gravados na tabela de dominância: %lld (%lld substituições)\n",
+                  dominance_stored, dominance_replaced);
+    }
+    write_log("Nós por segundo: %.0f\n",
+              best_sol->time > 0 ? nodes_explored / best_sol->time : 0.0);
+    write_log("Pico de nós ativos: %d\n", peak_active);
+    write_log("Pico de nós em memória: %zu (%.2f MB)\n", peak_live,
+              peak_live * main_worker->pool.block_size / (1024.0 * 1024.0));
+    write_log("Memória reservada para nós: %.2f MB em %zu slabs\n",
+              num_slabs * slab_bytes / (1024.0 * 1024.0), num_slabs);
+    if (search.num_workers > 1) {
+        for (int t = 0; t < search.num_workers; t++) {
+            BBWorker* w = &search.workers[t];
+            write_log("Thread %d: %lld nós explorados, %lld podados, %lld roubados\n",
+                      t, w->nodes_explored, w->nodes_pruned, w->nodes_stolen);
+        }
+    }
+
+    telemetry_counters(search.telemetry, nodes_explored, nodes_pruned, peak_active);
+    telemetry_finish(search.telemetry, best_sol);
 
-    write_log("Resultados finais:\n");
-    write_log("Status: %s\n", best_sol->feasible ? "Solução ótima encontrada" : "Tempo limite excedido");
+    write_log("\nResultados finais:\n");
+    write_log("Limite inferior: %.2f\n", bb_bound);
+    write_log("Status: %s\n", best_sol->optimal ? "Solução ótima encontrada" :
+              best_sol->feasible ? "Solução viável (não ótima)" : "Sem solução viável");
+    if (stop != STOP_NONE) {
+        write_log("Parada: %s\n", stop_reason_text(stop));
+    }
     write_log("Custo: %.2f\n", best_sol->cost);
     write_log("Tempo: %.2f s\n", best_sol->time);
     write_log("Gap: %.2f%%\n", best_sol->gap);
@@ -439,20 +1734,98 @@ Solution* solve_bb(const Instance* inst, const char* nome_arquivo) {
         best_sol->total_time = total_time;
     }
 
-    // Explicação de viabilidade no formato do PLI
-    if (best_sol->feasible) {
-        write_log("Solução é viável porque:\n");
-        write_log("- Todas as cidades são visitadas exatamente uma vez\n");
-        write_log("- Tempo total (%d) respeita o poder de KingsLanding (%d)\n", 
-                 best_sol->total_time, inst->houses[0].power);
-        write_log("- Rota forma um ciclo válido começando e terminando em KingsLanding\n");
-    } else {
-        write_log("Solução inviável porque:\n");
-        write_log("- Existem cidades repetidas na rota\n");
-        write_log("- Existem cidades não visitadas\n");
-    }
+    explain_feasibility(inst, best_sol);
 
-    free(active);
+    search_destroy(&search);
     close_log();
     return best_sol;
-}
\ No newline at end of file
+}
+
+// Micro-benchmarks (bench_solver.c): uma busca de uma thread, sem log nem
+// telemetria, com a rota do vizinho mais próximo como incumbente e um nó
+// fixo que segue essa rota até a profundidade pedida
+struct BBBench {
+    BBSearch search;
+    Node* node;
+};
+
+BBBench* bb_bench_create(const Instance* inst, int depth) {
+    int n = inst->n;
+    if (n < 3 || depth < 0 || depth > n - 3) {
+        return NULL;
+    }
+    BBBench* b = (BBBench*)calloc(1, sizeof(BBBench));
+    BBSearch* search = &b->search;
+    search->inst = inst;
+    search->best_sol = (Solution*)calloc(1, sizeof(Solution));
+    search->best_sol->route = (int*)malloc(n * sizeof(int));
+    pthread_mutex_init(&search->incumbent_lock, NULL);
+    nearest_neighbour_tour(inst, search->best_sol->route);
+    atomic_init(&search->incumbent, calculate_cost(inst, search->best_sol->route));
+    atomic_init(&search->pending, 0);
+    atomic_init(&search->next_report, DBL_MAX);
+    search->max_open = LONG_MAX;
+    clock_gettime(CLOCK_MONOTONIC, &search->start_time);
+
+    search->num_workers = 1;
+    search->workers = (BBWorker*)calloc(1, sizeof(BBWorker));
+    BBWorker* w = &search->workers[0];
+    worker_init(w, search, 0, n);
+
+    // Nó com os depth primeiros passos da rota incumbente
+    const int* route = search->best_sol->route;
+    Node* node = node_pool_alloc(&w->pool);
+    if (!node) {
+        bb_bench_free(b);
+        return NULL;
+    }
+    memset(node->path, -1, n * sizeof(int));
+    memset(node->visited, 0, n * sizeof(int));
+    node->level = depth;
+    node->cost = inst->houses[0].min_time;
+    node->total_time = inst->houses[0].min_time;
+    node->path[0] = 0;
+    node->visited[0] = 1;
+    node->zobrist = 0;
+    for (int k = 1; k <= depth; k++) {
+        int city = route[k];
+        node->cost += inst->cost[route[k - 1] * n + city] + inst->houses[city].min_time;
+        node->total_time += inst->houses[city].min_time;
+        node->path[k] = city;
+        node->visited[city] = 1;
+    }
+    if (node->pi) {
+        memset(node->pi, 0, n * sizeof(double));
+    }
+    node->bound = calculate_bound(inst, node);
+    b->node = node;
+    return b;
+}
+
+// calculate_bound do nó fixo
+double bb_bench_bound(BBBench* b) {
+    return calculate_bound(b->search.inst, b->node);
+}
+
+// Uma expansão do nó fixo (Held-Karp nos filhos até config.hk_depth). Os
+// filhos gerados são devolvidos ao pool; retorna quantos foram gerados
+int bb_bench_expand(BBBench* b) {
+    BBWorker* w = &b->search.workers[0];
+    worker_expand(w, b->node);
+    int num_children = 0;
+    int from_stack;
+    Node* child;
+    while ((child = frontier_pop(&w->frontier, &from_stack)) != NULL) {
+        node_pool_free(&w->pool, child);
+        num_children++;
+    }
+    atomic_store(&b->search.pending, 0);
+    return num_children;
+}
+
+void bb_bench_free(BBBench* b) {
+    if (!b) return;
+    search_destroy(&b->search);
+    free_solution(b->search.best_sol);
+    free(b);
+}
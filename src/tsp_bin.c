@@ -0,0 +1,237 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Formato binário de instâncias (versão 1)
+ *
+ * - Cabeçalho de 64 bytes (TspBinHeader)
+ * - n registros de casas (TspBinHouse)
+ * - Três matrizes n x n de double, linha a linha: custo
+ *   (distância * (1 + risco)), distância e risco. Cada bloco começa em um
+ *   múltiplo de COST_MATRIX_ALIGN
+ *
+ * O arquivo é carregado com mmap e as matrizes são usadas direto do
+ * mapeamento, sem cópia: inst->cost aponta para o bloco de custo e
+ * dist[i]/risk[i] para as linhas dos outros dois. Só os registros das casas
+ * (O(n)) são copiados. Os números ficam na ordem de bytes da máquina que
+ * gravou o arquivo; o campo byte_order permite recusar arquivos gravados
+ * em outra arquitetura.
+ */
+
+#define TSP_BIN_MAGIC "TSPBIN1"         // 8 bytes com o '\0'
+#define TSP_BIN_VERSION 1
+#define TSP_BIN_BYTE_ORDER 0x01020304u
+
+// Cabeçalho do arquivo
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t n;
+    uint32_t house_size;        // sizeof(TspBinHouse) de quem gravou
+    uint64_t houses_offset;
+    uint64_t cost_offset;
+    uint64_t dist_offset;
+    uint64_t risk_offset;
+    uint64_t file_size;
+} TspBinHeader;
+
+// Registro de uma casa (campos de tamanho fixo)
+typedef struct {
+    char name[100];
+    int32_t power;
+    int32_t min_time;
+    double loyalty;
+} TspBinHouse;
+
+_Static_assert(sizeof(TspBinHeader) == 64, "cabeçalho binário deve ter 64 bytes");
+
+// Arredonda para o próximo múltiplo do alinhamento das matrizes
+static uint64_t bin_align(uint64_t offset) {
+    return (offset + COST_MATRIX_ALIGN - 1) / COST_MATRIX_ALIGN * COST_MATRIX_ALIGN;
+}
+
+// Calcula os deslocamentos dos blocos para n cidades
+static void bin_layout(TspBinHeader* h, uint32_t n) {
+    uint64_t matrix = (uint64_t)n * n * sizeof(double);
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, TSP_BIN_MAGIC, sizeof(h->magic));
+    h->version = TSP_BIN_VERSION;
+    h->byte_order = TSP_BIN_BYTE_ORDER;
+    h->n = n;
+    h->house_size = sizeof(TspBinHouse);
+    h->houses_offset = sizeof(TspBinHeader);
+    h->cost_offset = bin_align(h->houses_offset + (uint64_t)n * sizeof(TspBinHouse));
+    h->dist_offset = bin_align(h->cost_offset + matrix);
+    h->risk_offset = bin_align(h->dist_offset + matrix);
+    h->file_size = h->risk_offset + matrix;
+}
+
+// Verifica se o arquivo começa com a assinatura do formato binário
+int is_binary_instance(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    if (!f) return 0;
+    char magic[8];
+    int ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+             memcmp(magic, TSP_BIN_MAGIC, sizeof(magic)) == 0;
+    fclose(f);
+    return ok;
+}
+
+// Número de cidades gravado no cabeçalho (0 se o cabeçalho não pode ser lido)
+int bin_instance_cities(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    if (!f) return 0;
+    TspBinHeader h;
+    int ok = fread(&h, sizeof(h), 1, f) == 1;
+    fclose(f);
+    return ok ? (int)h.n : 0;
+}
+
+// Grava a linha i de uma matriz no bloco que começa em offset
+static int bin_write_row(FILE* f, uint64_t offset, int n, int i, const double* row) {
+    return fseeko(f, (off_t)(offset + (uint64_t)i * n * sizeof(double)), SEEK_SET) == 0 &&
+           fwrite(row, sizeof(double), n, f) == (size_t)n;
+}
+
+// Grava no formato binário uma instância fornecida linha a linha:
+// row(data, i, cost, dist, risk) preenche a linha i das três matrizes. Só
+// uma linha fica em memória, então instâncias maiores que a memória podem
+// ser geradas direto em disco. Retorna 0 em caso de erro
+int write_instance_bin_rows(const char* filename, int n, const House* houses,
+                            BinRowFn row, void* data) {
+    FILE* f = fopen(filename, "wb");
+    if (!f) {
+        printf("Erro ao criar arquivo %s\n", filename);
+        return 0;
+    }
+    TspBinHeader h;
+    bin_layout(&h, n);
+    int ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+    for (int i = 0; ok && i < n; i++) {
+        TspBinHouse rec;
+        memset(&rec, 0, sizeof(rec));
+        // Só o nome: o que vem depois do '\0' não entra no arquivo
+        memcpy(rec.name, houses[i].name, strnlen(houses[i].name, sizeof(rec.name) - 1));
+        rec.power = houses[i].power;
+        rec.min_time = houses[i].min_time;
+        rec.loyalty = houses[i].loyalty;
+        ok = fwrite(&rec, sizeof(rec), 1, f) == 1;
+    }
+
+    // O espaço entre os blocos fica com zeros (posições nunca escritas)
+    double* buffer = (double*)malloc(3 * (size_t)n * sizeof(double));
+    ok = ok && buffer;
+    for (int i = 0; ok && i < n; i++) {
+        double* cost = buffer;
+        double* dist = buffer + n;
+        double* risk = buffer + 2 * (size_t)n;
+        row(data, i, cost, dist, risk);
+        ok = bin_write_row(f, h.cost_offset, n, i, cost) &&
+             bin_write_row(f, h.dist_offset, n, i, dist) &&
+             bin_write_row(f, h.risk_offset, n, i, risk);
+    }
+    free(buffer);
+
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) {
+        printf("Erro ao gravar arquivo %s\n", filename);
+    }
+    return ok;
+}
+
+// Copia a linha i de uma instância carregada
+static void instance_row(void* data, int i, double* cost, double* dist, double* risk) {
+    const Instance* inst = (const Instance*)data;
+    int n = inst->n;
+    memcpy(cost, inst->cost + (size_t)i * n, n * sizeof(double));
+    memcpy(dist, inst->dist[i], n * sizeof(double));
+    memcpy(risk, inst->risk[i], n * sizeof(double));
+}
+
+// Grava a instância no formato binário. Retorna 0 em caso de erro
+int write_instance_bin(const Instance* inst, const char* filename) {
+    return write_instance_bin_rows(filename, inst->n, inst->houses, instance_row,
+                                   (void*)inst);
+}
+
+// Carrega instância no formato binário via mmap
+Instance* read_instance_bin(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro ao abrir arquivo %s\n", filename);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TspBinHeader)) {
+        printf("Arquivo binário truncado: %s\n", filename);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Erro ao mapear arquivo %s\n", filename);
+        return NULL;
+    }
+
+    // Valida o cabeçalho contra o layout esperado para n
+    const TspBinHeader* h = (const TspBinHeader*)map;
+    TspBinHeader expected;
+    bin_layout(&expected, h->n);
+    const char* error = NULL;
+    if (memcmp(h->magic, TSP_BIN_MAGIC, sizeof(h->magic)) != 0) {
+        error = "assinatura inválida";
+    } else if (h->version != TSP_BIN_VERSION) {
+        error = "versão não suportada";
+    } else if (h->byte_order != TSP_BIN_BYTE_ORDER) {
+        error = "ordem de bytes de outra arquitetura";
+    } else if (h->n == 0 || h->n > MAX_CITIES || h->house_size != sizeof(TspBinHouse)) {
+        error = "cabeçalho inválido";
+    } else if (memcmp(h, &expected, sizeof(expected)) != 0 || h->file_size > size) {
+        error = "blocos fora do arquivo";
+    }
+    if (error) {
+        printf("Instância binária inválida (%s): %s\n", error, filename);
+        munmap(map, size);
+        return NULL;
+    }
+
+    int n = (int)h->n;
+    const char* base = (const char*)map;
+    Instance* inst = (Instance*)malloc(sizeof(Instance));
+    inst->n = n;
+    inst->map = map;
+    inst->map_size = size;
+
+    const TspBinHouse* rec = (const TspBinHouse*)(base + h->houses_offset);
+    inst->houses = (House*)malloc(n * sizeof(House));
+    for (int i = 0; i < n; i++) {
+        memcpy(inst->houses[i].name, rec[i].name, sizeof(inst->houses[i].name));
+        inst->houses[i].name[sizeof(inst->houses[i].name) - 1] = '\0';
+        inst->houses[i].power = rec[i].power;
+        inst->houses[i].min_time = rec[i].min_time;
+        inst->houses[i].loyalty = rec[i].loyalty;
+    }
+
+    // Matrizes apontam para o mapeamento (somente leitura)
+    double* dist = (double*)(base + h->dist_offset);
+    double* risk = (double*)(base + h->risk_offset);
+    inst->cost = (double*)(base + h->cost_offset);
+    inst->dist = (double**)malloc(n * sizeof(double*));
+    inst->risk = (double**)malloc(n * sizeof(double*));
+    for (int i = 0; i < n; i++) {
+        inst->dist[i] = dist + (size_t)i * n;
+        inst->risk[i] = risk + (size_t)i * n;
+    }
+    return inst;
+}
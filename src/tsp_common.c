@@ -2,98 +2,212 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
 
-// Inicialização da variável global
-FILE* log_file = NULL;
+// Configuração global (valores padrão definidos por init_config)
+Config config;
 
-// Implementação da função write_log
-void write_log(const char* format, ...) {
-    va_list args;
-    
-    // Remove o print na tela
-    // va_start(args, format);
-    // vprintf(format, args);
-    // va_end(args);
-    
-    // Mantém a escrita no arquivo de log
-    if (log_file) {
-        va_start(args, format);
-        vfprintf(log_file, format, args);
-        va_end(args);
-        fflush(log_file);
+// Preenche a configuração com os valores padrão
+void init_config(Config* cfg) {
+    cfg->engine = ENGINE_BB;
+    cfg->hk_depth = 3;
+    cfg->hk_root_iter = 200;
+    cfg->hk_node_iter = 20;
+    cfg->threads = 1;
+    cfg->strategy = BB_BEST_FIRST;
+    cfg->dive_freq = 100;
+    cfg->max_open_mb = 1024;
+    cfg->dominance_mb = 64;
+    cfg->dp_mem_mb = 4096;
+    cfg->heuristic = 1;
+    cfg->lk_neighbours = 10;
+    cfg->lk_time = 10.0;
+    cfg->formulation = MIP_MTZ;
+    cfg->mip_names = 0;
+    cfg->initial_tour = NULL;
+    cfg->tour_output = NULL;
+    cfg->portfolio_size = 0;
+    cfg->log_level = LOG_INFO;
+    cfg->progress_interval = 5.0;
+    cfg->telemetry_csv = NULL;
+    cfg->time_limit = 600.0;
+    cfg->node_limit = 0;
+    cfg->mem_limit_mb = 0;
+    cfg->target_gap = -1.0;
+}
+
+// Nomes das estratégias de seleção de nós, na ordem de BBStrategy
+static const char* strategy_names[] = { "best", "dfs", "dive", "cyclic" };
+
+// Nome de uma estratégia (usado na linha de comando e nos logs)
+const char* strategy_name(BBStrategy strategy) {
+    return strategy_names[strategy];
+}
+
+// Converte o nome de uma estratégia; retorna 0 se o nome não existe
+int parse_strategy(const char* name, BBStrategy* strategy) {
+    for (int i = 0; i < (int)(sizeof(strategy_names) / sizeof(strategy_names[0])); i++) {
+        if (strcmp(name, strategy_names[i]) == 0) {
+            *strategy = (BBStrategy)i;
+            return 1;
+        }
     }
+    return 0;
+}
+
+// Nomes dos métodos de solução, na ordem de Engine
+static const char* engine_names[] = { "bb", "mip", "dp", "lk" };
+
+// Nome de um método de solução
+const char* engine_name(Engine engine) {
+    return engine_names[engine];
 }
 
-// Função para abrir arquivo de log
-void open_log(const char* filename) {
-    log_file = fopen(filename, "w");
-    if (!log_file) {
-        printf("Erro ao abrir arquivo de log: %s\n", filename);
-        exit(1);
+// Converte o nome de um método de solução; retorna 0 se o nome não existe
+int parse_engine(const char* name, Engine* engine) {
+    for (int i = 0; i < (int)(sizeof(engine_names) / sizeof(engine_names[0])); i++) {
+        if (strcmp(name, engine_names[i]) == 0) {
+            *engine = (Engine)i;
+            return 1;
+        }
     }
+    return 0;
 }
 
-// Função para fechar arquivo de log
-void close_log() {
-    if (log_file) {
-        fclose(log_file);
-        log_file = NULL;
+// Nomes das formulações do PLI, na ordem de MipFormulation
+static const char* formulation_names[] = { "mtz", "dfj" };
+
+// Nome de uma formulação do PLI
+const char* formulation_name(MipFormulation formulation) {
+    return formulation_names[formulation];
+}
+
+// Converte o nome de uma formulação do PLI; retorna 0 se o nome não existe
+int parse_formulation(const char* name, MipFormulation* formulation) {
+    for (int i = 0; i < (int)(sizeof(formulation_names) / sizeof(formulation_names[0])); i++) {
+        if (strcmp(name, formulation_names[i]) == 0) {
+            *formulation = (MipFormulation)i;
+            return 1;
+        }
     }
+    return 0;
 }
 
-// Função para ler instância do arquivo
-Instance* read_instance(const char* filename) {
-    FILE* f = fopen(filename, "r");
+// Nomes dos níveis de log, na ordem de LogLevel
+static const char* log_level_names[] = { "error", "info", "debug" };
+
+// Nome de um nível de log
+const char* log_level_name(LogLevel level) {
+    return log_level_names[level];
+}
+
+// Converte o nome de um nível de log; retorna 0 se o nome não existe
+int parse_log_level(const char* name, LogLevel* level) {
+    for (int i = 0; i < (int)(sizeof(log_level_names) / sizeof(log_level_names[0])); i++) {
+        if (strcmp(name, log_level_names[i]) == 0) {
+            *level = (LogLevel)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Descrição de um motivo de parada (usada nos logs), na ordem de StopReason
+static const char* stop_reason_texts[] = {
+    "busca concluída", "tempo limite excedido", "limite de nós atingido",
+    "limite de memória atingido", "gap alvo atingido", "interrompida por sinal",
+    "interrompida pelo portfólio"
+};
+
+const char* stop_reason_text(StopReason reason) {
+    return stop_reason_texts[reason];
+}
+
+// Pico de memória residente do processo, em KB (no modo lote e no
+// portfólio inclui as outras execuções em andamento)
+long peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // Bytes no macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+// Memória residente atual do processo, em KB. Sem /proc (macOS) usa o pico
+long current_rss_kb(void) {
+    FILE* f = fopen("/proc/self/statm", "r");
     if (!f) {
-        printf("Erro ao abrir arquivo %s\n", filename);
-        return NULL;
+        return peak_rss_kb();
     }
-    
-    Instance* inst = (Instance*)malloc(sizeof(Instance));
-    
-    // Lê número de casas
-    fscanf(f, "%d", &inst->n);
-    
-    // Aloca memória
-    inst->houses = (House*)malloc(inst->n * sizeof(House));
-    inst->dist = (double**)malloc(inst->n * sizeof(double*));
-    inst->risk = (double**)malloc(inst->n * sizeof(double*));
-    
-    for (int i = 0; i < inst->n; i++) {
-        inst->dist[i] = (double*)malloc(inst->n * sizeof(double));
-        inst->risk[i] = (double*)malloc(inst->n * sizeof(double));
+    long size, resident;
+    int ok = fscanf(f, "%ld %ld", &size, &resident) == 2;
+    fclose(f);
+    return ok ? resident * (sysconf(_SC_PAGESIZE) / 1024) : peak_rss_kb();
+}
+
+// Função para ler instância do arquivo (texto ou formato binário)
+Instance* read_instance(const char* filename) {
+    if (is_binary_instance(filename)) {
+        return read_instance_bin(filename);
     }
-    
-    // Lê dados das casas
-    for (int i = 0; i < inst->n; i++) {
-        char name[100];
-        fscanf(f, "%s %d %lf %d", 
-            name,
-            &inst->houses[i].power,
-            &inst->houses[i].loyalty,
-            &inst->houses[i].min_time);
-            
-        // Copia o nome usando strncpy
-        strncpy(inst->houses[i].name, name, sizeof(inst->houses[i].name) - 1);
-        inst->houses[i].name[sizeof(inst->houses[i].name) - 1] = '\0';
+    return read_instance_text(filename);
+}
+
+// Número de cidades de uma instância sem carregar as matrizes (0 se o
+// arquivo não abre ou não começa com o número de cidades)
+int instance_cities(const char* filename) {
+    if (is_binary_instance(filename)) {
+        return bin_instance_cities(filename);
     }
-    
-    // Lê matriz de distâncias
-    for (int i = 0; i < inst->n; i++) {
-        for (int j = 0; j < inst->n; j++) {
-            fscanf(f, "%lf", &inst->dist[i][j]);
-        }
+    FILE* f = fopen(filename, "r");
+    if (!f) return 0;
+    int n = 0;
+    if (fscanf(f, "%d", &n) != 1 || n < 0) {
+        n = 0;
+    }
+    fclose(f);
+    return n;
+}
+
+// Nome da instância: nome do arquivo sem diretório e sem extensão. Dá nome
+// aos logs, à telemetria e às rotas do lote
+void instance_base_name(const char* filename, char* name, size_t size) {
+    const char* base = strrchr(filename, '/');
+    snprintf(name, size, "%s", base ? base + 1 : filename);
+    char* dot = strrchr(name, '.');
+    if (dot) {
+        *dot = '\0';
+    }
+}
+
+// Constrói matriz de custos contígua, alinhada e linha a linha:
+// cost[i*n + j] = dist[i][j] * (1 + risk[i][j]) (+ min_time[j] se with_min_time)
+double* build_cost_matrix(const Instance* inst, int with_min_time) {
+    int n = inst->n;
+    size_t bytes = (size_t)n * n * sizeof(double);
+    void* mem = NULL;
+    if (posix_memalign(&mem, COST_MATRIX_ALIGN, bytes ? bytes : COST_MATRIX_ALIGN) != 0) {
+        printf("Erro ao alocar matriz de custos (%d x %d)\n", n, n);
+        return NULL;
     }
     
-    // Lê matriz de riscos
-    for (int i = 0; i < inst->n; i++) {
-        for (int j = 0; j < inst->n; j++) {
-            fscanf(f, "%lf", &inst->risk[i][j]);
+    double* cost = (double*)mem;
+    for (int i = 0; i < n; i++) {
+        double* row = cost + (size_t)i * n;
+        for (int j = 0; j < n; j++) {
+            row[j] = inst->dist[i][j] * (1.0 + inst->risk[i][j]);
+            if (with_min_time) {
+                row[j] += inst->houses[j].min_time;
+            }
         }
     }
-    
-    fclose(f);
-    return inst;
+    return cost;
 }
 
 // Função para escrever solução em arquivo
@@ -118,20 +232,71 @@ void write_solution(const char* filename, const Solution* sol, const Instance* i
     fclose(f);
 }
 
+// Lê uma rota de arquivo: as últimas n palavras do arquivo, cada uma o
+// índice (0..n-1) ou o nome de uma cidade. Aceita a saída de
+// write_solution, uma lista de índices ou a linha "Rota:" impressa pelos
+// executáveis. A rota é girada para começar em KingsLanding.
+// Retorna 0 se o arquivo não contém uma permutação das cidades
+int read_tour(const Instance* inst, const char* filename, int* route) {
+    FILE* f = fopen(filename, "r");
+    if (!f) {
+        printf("Erro ao abrir arquivo %s\n", filename);
+        return 0;
+    }
+    int n = inst->n;
+
+    // Guarda as últimas n palavras em um buffer circular
+    char (*words)[100] = malloc(n * sizeof(*words));
+    long count = 0;
+    char word[100];
+    while (fscanf(f, "%99s", word) == 1) {
+        strcpy(words[count % n], word);
+        count++;
+    }
+    fclose(f);
+
+    int* seen = (int*)calloc(n, sizeof(int));
+    int ok = count >= n;
+    for (int k = 0; ok && k < n; k++) {
+        const char* w = words[(count - n + k) % n];
+        char* end;
+        long city = strtol(w, &end, 10);
+        if (*end != '\0') {
+            city = -1;
+            for (int i = 0; i < n; i++) {
+                if (strcmp(w, inst->houses[i].name) == 0) {
+                    city = i;
+                    break;
+                }
+            }
+        }
+        if (city < 0 || city >= n || seen[city]) {
+            ok = 0;
+        } else {
+            seen[city] = 1;
+            route[k] = (int)city;
+        }
+    }
+    if (!ok) {
+        printf("Rota inválida em %s: esperava uma permutação das %d cidades\n", filename, n);
+    } else {
+        // Gira a rota para começar na cidade 0
+        int start = 0;
+        while (route[start] != 0) start++;
+        for (int k = 0; k < n; k++) {
+            seen[k] = route[(start + k) % n];
+        }
+        memcpy(route, seen, n * sizeof(int));
+    }
+    free(seen);
+    free(words);
+    return ok;
+}
+
 // Função para calcular custo de uma rota
 double calculate_cost(const Instance* inst, const int* route) {
-    double cost = 0.0;
-    
-    // Soma custos das arestas
-    for (int i = 0; i < inst->n-1; i++) {
-        int from = route[i];
-        int to = route[i+1];
-        cost += inst->dist[from][to] * (1.0 + inst->risk[from][to]);
-    }
-    
-    // Adiciona retorno a Porto Real
-    int last = route[inst->n-1];
-    cost += inst->dist[last][0] * (1.0 + inst->risk[last][0]);
+    // Soma custos das arestas, incluindo o retorno a Porto Real
+    double cost = simd.tour_sum(inst->cost, inst->n, route);
     
     // Adiciona tempos mínimos de cada casa
     for (int i = 0; i < inst->n; i++) {
@@ -148,13 +313,21 @@ void free_instance(Instance* inst) {
     // Libera vetores
     free(inst->houses);
     
-    // Libera matrizes
-    for (int i = 0; i < inst->n; i++) {
-        free(inst->dist[i]);
-        free(inst->risk[i]);
+    // Matrizes do formato binário pertencem ao mapeamento
+    if (inst->map) {
+        munmap(inst->map, inst->map_size);
+        free(inst->dist);
+        free(inst->risk);
+        free(inst);
+        return;
     }
+    
+    // Libera matrizes (cada uma em um único bloco, apontado pela linha 0)
+    free(inst->dist[0]);
+    free(inst->risk[0]);
     free(inst->dist);
     free(inst->risk);
+    free(inst->cost);
     
     free(inst);
 }
@@ -167,9 +340,9 @@ void free_solution(Solution* sol) {
 }
 
 // Função para explicar viabilidade
-void explain_feasibility(const Instance* inst, const Solution* sol, FILE* log_file) {
+void explain_feasibility(const Instance* inst, const Solution* sol) {
     if (!sol->feasible) {
-        fprintf(log_file, "\nSolução inviável porque:\n");
+        write_log("\nSolução inviável porque:\n");
         
         // Verifica se todos os nós foram visitados
         int has_repeated = 0;
@@ -192,10 +365,10 @@ void explain_feasibility(const Instance* inst, const Solution* sol, FILE* log_fi
         }
         
         if (has_repeated) {
-            fprintf(log_file, "- Existem cidades repetidas na rota\n");
+            write_log("- Existem cidades repetidas na rota\n");
         }
         if (has_missing) {
-            fprintf(log_file, "- Existem cidades não visitadas\n");
+            write_log("- Existem cidades não visitadas\n");
         }
         
         // Verifica tempo total
@@ -207,22 +380,43 @@ void explain_feasibility(const Instance* inst, const Solution* sol, FILE* log_fi
         }
         
         if (total_time > inst->houses[0].power) {
-            fprintf(log_file, "- Tempo total (%d) excede o poder de KingsLanding (%d)\n", 
-                    total_time, inst->houses[0].power);
+            write_log("- Tempo total (%d) excede o poder de KingsLanding (%d)\n", 
+                      total_time, inst->houses[0].power);
         }
         
         free(visits);
     } else {
-        fprintf(log_file, "\nSolução é viável porque:\n");
-        fprintf(log_file, "- Todas as cidades são visitadas exatamente uma vez\n");
+        write_log("\nSolução é viável porque:\n");
+        write_log("- Todas as cidades são visitadas exatamente uma vez\n");
         
         int total_time = 0;
         for (int i = 0; i < inst->n; i++) {
             total_time += inst->houses[sol->route[i]].min_time;
         }
         
-        fprintf(log_file, "- Tempo total (%d) respeita o poder de KingsLanding (%d)\n",
-                total_time, inst->houses[0].power);
-        fprintf(log_file, "- Rota forma um ciclo válido começando e terminando em KingsLanding\n");
+        write_log("- Tempo total (%d) respeita o poder de KingsLanding (%d)\n",
+                  total_time, inst->houses[0].power);
+        write_log("- Rota forma um ciclo válido começando e terminando em KingsLanding\n");
     }
-} 
\ No newline at end of file
+} 
+
+// Registra a matriz de custos no log (só no nível LOG_DEBUG: são n² números).
+// Cada linha é montada inteira e enviada ao log de uma vez
+void log_cost_matrix(const Instance* inst) {
+    if (!log_enabled(LOG_DEBUG)) {
+        return;
+    }
+    int n = inst->n;
+    size_t size = (size_t)n * 16 + 2;
+    char* line = (char*)malloc(size);
+    write_log_at(LOG_DEBUG, "Matriz de custos (distância * (1 + risco)):\n");
+    for (int i = 0; i < n; i++) {
+        size_t len = 0;
+        for (int j = 0; j < n && len < size; j++) {
+            len += snprintf(line + len, size - len, "%7.2f ", inst->cost[(size_t)i * n + j]);
+        }
+        write_log_at(LOG_DEBUG, "%s\n", line);
+    }
+    write_log_at(LOG_DEBUG, "\n");
+    free(line);
+}
@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stddef.h>
 
 // Estrutura para representar uma casa
 typedef struct {
@@ -12,14 +13,33 @@ typedef struct {
     int min_time;
 } House;
 
+// Alinhamento (bytes) da matriz de custos: uma linha de cache
+#define COST_MATRIX_ALIGN 64
+
+// Maior número de cidades: n * n cabe em int, então os índices i * n + j
+// da matriz de custos não transbordam em nenhum método
+#define MAX_CITIES 46340
+
 // Estrutura para representar uma instância
 typedef struct {
     int n;
     House* houses;
     double** dist;
     double** risk;
+    double* cost;       // Matriz n x n (linha a linha): dist[i][j] * (1 + risk[i][j])
+    void* map;          // Arquivo binário mapeado com as matrizes (NULL se lido do texto)
+    size_t map_size;
 } Instance;
 
+// Métodos de solução
+typedef enum {
+    ENGINE_BB,              // Branch and Bound
+    ENGINE_MIP,             // Programação linear inteira com GLPK
+    ENGINE_DP,              // Programação dinâmica de Held-Karp
+    ENGINE_LK,              // Busca local iterada estilo Lin-Kernighan (heurística)
+    ENGINE_COUNT
+} Engine;
+
 // Estrutura para representar uma solução
 typedef struct {
     int* route;
@@ -28,28 +48,257 @@ typedef struct {
     double gap;
     int feasible;
     int total_time;
+    int optimal;            // O método provou otimalidade (parar no gap alvo não conta)
+    Engine engine;          // Método que encontrou a rota
 } Solution;
 
-// Variável global para arquivo de log
-FILE* log_file;  // Removido o extern
+// Estratégias de seleção de nós do Branch and Bound
+typedef enum {
+    BB_BEST_FIRST,          // Menor bound primeiro
+    BB_DEPTH_FIRST,         // Profundidade primeiro (filho de menor bound antes)
+    BB_DIVE,                // Menor bound, com mergulhos periódicos em profundidade
+    BB_CYCLIC               // Menor bound de cada nível, ciclando entre os níveis
+} BBStrategy;
+
+// Formulações do PLI para eliminar subciclos
+typedef enum {
+    MIP_MTZ,                // Miller-Tucker-Zemlin: variáveis de ordem u[i] e (n-1)² restrições
+    MIP_DFJ                 // Dantzig-Fulkerson-Johnson: cortes de subciclo gerados sob demanda
+} MipFormulation;
+
+// Níveis de log: cada nível inclui as mensagens dos anteriores
+typedef enum {
+    LOG_ERROR,              // Só erros
+    LOG_INFO,               // Andamento e resultados (padrão)
+    LOG_DEBUG               // Também a matriz de custos e detalhes internos
+} LogLevel;
+
+// Motivos para um método encerrar a busca antes de provar a otimalidade
+typedef enum {
+    STOP_NONE,              // A busca terminou (ou ainda não parou)
+    STOP_TIME,              // Tempo limite
+    STOP_NODES,             // Limite de nós
+    STOP_MEMORY,            // Limite de memória
+    STOP_GAP,               // Gap alvo atingido
+    STOP_SIGNAL,            // SIGINT ou SIGTERM
+    STOP_PORTFOLIO          // Outro método do portfólio encerrou a instância
+} StopReason;
+
+// Parâmetros de execução (preenchidos a partir da linha de comando)
+typedef struct {
+    Engine engine;          // Método de solução
+    int hk_depth;           // Profundidade máxima dos nós com limite de Held-Karp (-1 = desligado, 0 = só raiz)
+    int hk_root_iter;       // Iterações de subgradiente na raiz
+    int hk_node_iter;       // Iterações de subgradiente nos demais nós
+    int threads;            // Threads do Branch and Bound
+    BBStrategy strategy;    // Seleção de nós do Branch and Bound
+    int dive_freq;          // Seleções pelo menor bound entre dois mergulhos (BB_DIVE)
+    int max_open_mb;        // Memória máxima dos nós abertos antes de passar a profundidade (0 = sem limite)
+    int dominance_mb;       // Memória da tabela de dominância do BB (0 = desligada)
+    int dp_mem_mb;          // Memória máxima das tabelas da programação dinâmica
+    int heuristic;          // Executa a heurística inicial antes do BB e do PLI
+    int lk_neighbours;      // Candidatos por cidade na heurística LK
+    double lk_time;         // Tempo (s) da heurística LK
+    MipFormulation formulation; // Eliminação de subciclos do PLI
+    int mip_names;          // Gera nomes de linhas e colunas no modelo do PLI
+    const char* initial_tour;   // Arquivo com a rota inicial do PLI (NULL = nenhum)
+    const char* tour_output;    // Arquivo onde gravar a solução (NULL = não grava)
+    int portfolio_size;         // Métodos do portfólio (0 = um método só)
+    Engine portfolio[ENGINE_COUNT]; // Métodos executados ao mesmo tempo no portfólio
+    LogLevel log_level;         // Mensagens com nível acima deste não são registradas
+    double progress_interval;   // Intervalo (s) entre os registros de progresso
+    const char* telemetry_csv;  // CSV com uma linha por execução (NULL = não grava)
+    double time_limit;          // Tempo limite (s) de cada método
+    long long node_limit;       // Nós explorados pelo BB ou pelo PLI (0 = sem limite)
+    int mem_limit_mb;           // Memória residente do processo (0 = sem limite)
+    double target_gap;          // Gap (%) que encerra a busca (< 0 = padrão do método)
+} Config;
+
+// Configuração global (definida em tsp_common.c)
+extern Config config;
 
-// Funções de log
+// Área de trabalho para o cálculo do limite de Held-Karp
+typedef struct {
+    int n;
+    int* cities;        // Cidades não visitadas (vértices da 1-árvore)
+    int* degree;        // Grau de cada vértice na 1-árvore
+    int* parent;        // Pai de cada vértice na árvore geradora (Prim)
+    int* in_tree;       // Marca vértices já incluídos na árvore
+    double* key;        // Menor custo de ligação à árvore
+    double* best_pi;    // Penalidades da melhor iteração
+} HKWorkspace;
+
+// Kernels dos laços internos (escalar/SSE2/AVX2/AVX-512, escolhidos em simd_init)
+typedef struct {
+    const char* name;
+    // Menor row[j] com mask[j] == 0 e j != skip (mask pode ser NULL, skip -1)
+    double (*masked_min)(const double* row, const int* mask, int n, int skip);
+    // Duas menores entradas válidas da linha e o índice da menor
+    void (*two_min)(const double* row, const int* mask, int n, int skip,
+                    double* min1, double* min2, int* arg1);
+    // Soma dos custos das arestas da rota fechada (volta para a cidade 0)
+    double (*tour_sum)(const double* cost, int n, const int* route);
+} SimdKernels;
+
+// Kernels em uso (definidos em tsp_simd.c)
+extern SimdKernels simd;
+
+// Arquivo de log da thread atual (definido em tsp_common.c). É local a cada
+// thread para que as instâncias do modo lote escrevam em logs separados
+extern _Thread_local FILE* log_file;
+
+// Funções de log (tsp_log.c). write_log registra no nível LOG_INFO
 void write_log(const char* format, ...);
+void write_log_at(LogLevel level, const char* format, ...);
 void open_log(const char* filename);
 void close_log(void);
+void log_shutdown(void);
+
+// Indica se uma mensagem do nível seria registrada (evita montar dados à toa)
+static inline int log_enabled(LogLevel level) {
+    return log_file && level <= config.log_level;
+}
 
 // Funções de solução
 Solution* solve_bb(const Instance* inst, const char* nome_arquivo);  // Adicionado
-Solution* solve_mip(const Instance* inst, const char* nome_arquivo); // Adicionado
+double calculate_initial_bound(const Instance* inst);
+Solution* solve_mip(const Instance* inst, const char* nome_arquivo,
+                    const int* initial_route); // Adicionado
+int mip_thread_safe(void);
+void mip_thread_done(void);
+Solution* solve_dp(const Instance* inst, const char* nome_arquivo);
+Solution* solve_lk(const Instance* inst, const char* nome_arquivo);
+
+// Seleção do método e portfólio (tsp_portfolio.c). As funções portfolio_*
+// agem sobre o portfólio da thread atual e não fazem nada fora dele
+typedef struct Portfolio Portfolio;
+int engine_available(Engine engine);
+const char* engine_title(Engine engine);
+Solution* solve_engine(Engine engine, const Instance* inst, const char* nome_arquivo,
+                       const int* initial_route);
+Solution* solve_portfolio(const Instance* inst, const char* nome_arquivo,
+                          const int* initial_route, const Engine* engines, int count);
+int parse_engine_list(const char* list, Engine* engines);
+int engines_thread_safe(const Engine* engines, int count);
+void request_stop(void);
+int stop_requested(void);
+StopReason limit_reached(double elapsed, long long nodes);
+int memory_limit_reached(void);
+double target_gap(double engine_default);
+void engine_thread_done(void);
+Portfolio* portfolio_current(void);
+void portfolio_attach(Portfolio* pf, Engine engine);
+int portfolio_offer(const int* route, double cost);
+int portfolio_fetch(int* route, double* cost);
+double portfolio_incumbent(void);
+void portfolio_bound(double bound);
+int portfolio_stopped(void);
+
+// Telemetria de uma execução (tsp_telemetry.c), gravada em logs/<instância>_<método>.json
+typedef struct Telemetry Telemetry;
+Telemetry* telemetry_create(const char* instance, Engine engine);
+double telemetry_elapsed(const Telemetry* t);
+void telemetry_phase(Telemetry* t, const char* name);
+void telemetry_point(Telemetry* t, double incumbent, double bound);
+void telemetry_counters(Telemetry* t, long long nodes_explored, long long nodes_pruned,
+                        long long peak_frontier);
+void telemetry_finish(Telemetry* t, const Solution* sol);
+
+// Heurísticas primais (tsp_heur.c)
+double nearest_neighbour_tour(const Instance* inst, int* route);
+double cheapest_insertion_tour(const Instance* inst, int* route);
+double two_opt(const Instance* inst, int* route);
+double or_opt(const Instance* inst, int* route);
+double local_search(const Instance* inst, int* route);
+int heuristic_tour(const Instance* inst, int* route, double* cost);
+
+// Limite de Held-Karp (tsp_hk.c)
+HKWorkspace* hk_workspace_create(int n);
+void hk_workspace_free(HKWorkspace* ws);
+double held_karp_bound(const Instance* inst, HKWorkspace* ws, const int* visited,
+                       int current, double* pi, int max_iter, double target);
+
+// Micro-benchmarks dos laços internos (bench_solver.c). bb_bench_create monta
+// uma busca de uma thread e um nó na profundidade depth da rota do vizinho
+// mais próximo (NULL sem memória para o nó); mip_bench_build monta e descarta o modelo do PLI (só com GLPK)
+typedef struct BBBench BBBench;
+BBBench* bb_bench_create(const Instance* inst, int depth);
+double bb_bench_bound(BBBench* b);
+int bb_bench_expand(BBBench* b);
+void bb_bench_free(BBBench* b);
+int mip_bench_build(const Instance* inst, int mtz);
+
+// Utilitários dos benchmarks (bench_common.c)
+double bench_now(void);
+int bench_write_instance(const char* filename, int n, unsigned int seed);
+
+// Configuração
+void init_config(Config* cfg);
+const char* strategy_name(BBStrategy strategy);
+int parse_strategy(const char* name, BBStrategy* strategy);
+const char* engine_name(Engine engine);
+int parse_engine(const char* name, Engine* engine);
+const char* formulation_name(MipFormulation formulation);
+int parse_formulation(const char* name, MipFormulation* formulation);
+const char* log_level_name(LogLevel level);
+int parse_log_level(const char* name, LogLevel* level);
+const char* stop_reason_text(StopReason reason);
+
+// Memória residente do processo, em KB (-1 se indisponível)
+long peak_rss_kb(void);
+long current_rss_kb(void);
+
+// Seleção dos kernels SIMD (tsp_simd.c)
+void simd_init(void);
 
 // Outras funções
 Instance* read_instance(const char* filename);
+Instance* read_instance_text(const char* filename);
+int instance_cities(const char* filename);
+void instance_base_name(const char* filename, char* name, size_t size);
+int read_tour(const Instance* inst, const char* filename, int* route);
+
+// Formato binário de instâncias (tsp_bin.c)
+int is_binary_instance(const char* filename);
+Instance* read_instance_bin(const char* filename);
+int bin_instance_cities(const char* filename);
+int write_instance_bin(const Instance* inst, const char* filename);
+typedef void (*BinRowFn)(void* data, int i, double* cost, double* dist, double* risk);
+int write_instance_bin_rows(const char* filename, int n, const House* houses,
+                            BinRowFn row, void* data);
+
+// Gerador de instâncias sintéticas (tsp_synth.c)
+typedef enum {
+    SYNTH_UNIFORM,          // Cidades uniformes em um quadrado, distância euclidiana
+    SYNTH_CLUSTERED,        // Cidades em torno de centros de agrupamentos
+    SYNTH_ASYMMETRIC        // Como uniform, com acréscimo próprio em cada arco
+} SynthModel;
+
+typedef struct {
+    int n;
+    SynthModel model;
+    unsigned long long seed;
+    double side;            // Lado do quadrado das coordenadas
+    int clusters;           // Agrupamentos (clustered; 0 = ~ raiz de n)
+    double asymmetry;       // Acréscimo máximo relativo de um arco (asymmetric)
+    double risk_max;        // Risco máximo de um arco
+    int max_min_time;       // Tempos mínimos em [1, max_min_time]
+    double slack;           // Folga do orçamento sobre a soma dos tempos mínimos
+} SynthParams;
+
+void synth_defaults(SynthParams* p, int n);
+const char* synth_model_name(SynthModel model);
+int parse_synth_model(const char* name, SynthModel* model);
+int synth_write(const SynthParams* p, const char* filename, int binary, int* budget);
+
 void write_solution(const char* filename, const Solution* sol, const Instance* inst);
 double calculate_cost(const Instance* inst, const int* route);
+double* build_cost_matrix(const Instance* inst, int with_min_time);
 void free_instance(Instance* inst);
 void free_solution(Solution* sol);
 
 // Adicionar ao header:
-void explain_feasibility(const Instance* inst, const Solution* sol, FILE* log_file);
+void explain_feasibility(const Instance* inst, const Solution* sol);
+void log_cost_matrix(const Instance* inst);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Converte uma instância do formato texto para o formato binário
+ * (ver tsp_bin.c). O arquivo gravado é lido de volta e comparado com a
+ * instância original antes de terminar.
+ */
+
+// Compara duas instâncias campo a campo; retorna 1 se são iguais
+static int same_instance(const Instance* a, const Instance* b) {
+    int n = a->n;
+    if (b->n != n) return 0;
+    for (int i = 0; i < n; i++) {
+        if (strcmp(a->houses[i].name, b->houses[i].name) != 0 ||
+            a->houses[i].power != b->houses[i].power ||
+            a->houses[i].min_time != b->houses[i].min_time ||
+            a->houses[i].loyalty != b->houses[i].loyalty) {
+            return 0;
+        }
+        if (memcmp(a->dist[i], b->dist[i], n * sizeof(double)) != 0 ||
+            memcmp(a->risk[i], b->risk[i], n * sizeof(double)) != 0) {
+            return 0;
+        }
+    }
+    return memcmp(a->cost, b->cost, (size_t)n * n * sizeof(double)) == 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        printf("Uso: %s entrada.txt saida.bin\n", argv[0]);
+        return 1;
+    }
+
+    Instance* inst = read_instance(argv[1]);
+    if (!inst) {
+        return 1;
+    }
+    if (!write_instance_bin(inst, argv[2])) {
+        free_instance(inst);
+        return 1;
+    }
+
+    Instance* check = read_instance_bin(argv[2]);
+    int ok = check && same_instance(inst, check);
+    if (ok) {
+        printf("%s: %d cidades convertidas para %s\n", argv[1], inst->n, argv[2]);
+    } else {
+        printf("Erro: %s não reproduz a instância original\n", argv[2]);
+    }
+
+    free_instance(check);
+    free_instance(inst);
+    return ok ? 0 : 1;
+}
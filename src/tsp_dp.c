@@ -0,0 +1,330 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+/**
+ * Resolve o TSP de forma exata pela programação dinâmica de Held-Karp
+ *
+ * Estados: (S, j), S subconjunto das cidades 1..n-1 e j ∈ S a última
+ * cidade visitada. dp[S][j] é o menor custo de um caminho que sai de
+ * KingsLanding, visita exatamente as cidades de S e termina em j:
+ *   dp[{j}][j] = c[0][j]
+ *   dp[S][j]   = min { dp[S \ {j}][i] + c[i][j] : i ∈ S \ {j} }
+ * e a rota ótima custa min { dp[todas][j] + c[j][0] } mais os tempos mínimos.
+ *
+ * Todas as rotas visitam todas as cidades, então o tempo total (soma dos
+ * tempos mínimos) é o mesmo para qualquer rota: o limite de poder de
+ * KingsLanding é verificado uma única vez, antes de montar as tabelas.
+ *
+ * As tabelas guardam só os pares com j ∈ S: as entradas de S ficam
+ * contíguas, na ordem crescente de j, a partir de offset[S]. Custos são
+ * float e o predecessor de cada estado ocupa um byte. Os subconjuntos de
+ * mesmo tamanho dependem apenas da camada anterior e são divididos entre
+ * as threads.
+ */
+
+// Tabelas da programação dinâmica
+typedef struct {
+    int n;              // Número de cidades
+    int m;              // Cidades fora de KingsLanding (bits do subconjunto)
+    uint32_t* offset;   // Início das entradas de cada subconjunto
+    float* cost;        // Custo de cada estado
+    uint8_t* parent;    // Cidade anterior a j no caminho ótimo de cada estado
+    float* arc;         // arc[j * n + i] = c[i][j] (coluna de j contígua)
+} DPTables;
+
+// Trabalho de uma thread em uma camada
+typedef struct {
+    const DPTables* t;
+    int size;           // Tamanho dos subconjuntos da camada
+    uint32_t first;     // Faixa de subconjuntos [first, last)
+    uint32_t last;
+} DPLayerTask;
+
+// Posição de j entre as entradas do subconjunto S
+static inline int dp_rank(uint32_t set, int bit) {
+    return __builtin_popcount(set & ((1u << bit) - 1));
+}
+
+// Preenche os estados dos subconjuntos de tamanho size na faixa da tarefa
+static void* dp_layer(void* arg) {
+    DPLayerTask* task = (DPLayerTask*)arg;
+    const DPTables* t = task->t;
+    int n = t->n;
+
+    for (uint32_t set = task->first; set < task->last; set++) {
+        if (__builtin_popcount(set) != task->size) continue;
+
+        float* out_cost = t->cost + t->offset[set];
+        uint8_t* out_parent = t->parent + t->offset[set];
+        int r = 0;
+
+        // Cada j ∈ S é a última cidade; o caminho anterior cobre S \ {j}
+        for (uint32_t js = set; js; js &= js - 1) {
+            int bit = __builtin_ctz(js);
+            int j = bit + 1;
+            uint32_t prev = set & ~(1u << bit);
+            const float* prev_cost = t->cost + t->offset[prev];
+            const float* arc_j = t->arc + j * n;
+
+            float best = FLT_MAX;
+            int best_i = 0;
+            int k = 0;
+            for (uint32_t is = prev; is; is &= is - 1, k++) {
+                int i = __builtin_ctz(is) + 1;
+                float value = prev_cost[k] + arc_j[i];
+                if (value < best) {
+                    best = value;
+                    best_i = i;
+                }
+            }
+            out_cost[r] = best;
+            out_parent[r] = (uint8_t)best_i;
+            r++;
+        }
+    }
+    return NULL;
+}
+
+// Resolve TSP usando programação dinâmica
+Solution* solve_dp(const Instance* inst, const char* nome_arquivo) {
+    int n = inst->n;
+
+    // Nome base do arquivo, sem o caminho e sem a extensão
+    char instance_name[256];
+    instance_base_name(nome_arquivo, instance_name, sizeof(instance_name));
+
+    // Cria nome do arquivo de log
+    char log_filename[300];
+    snprintf(log_filename, sizeof(log_filename), "logs/%s_DP.log", instance_name);
+    open_log(log_filename);
+
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    write_log("=== Programação dinâmica (Held-Karp) para TSP ===\n");
+    write_log("Instância: %s\n", instance_name);
+    write_log("Método: DP\n");
+    write_log("Número de cidades: %d\n\n", n);
+
+    // Memória das tabelas: m * 2^(m-1) estados de 5 bytes, um deslocamento
+    // de 4 bytes por subconjunto e a matriz de custos em float
+    int m = n - 1;
+    double states = m > 0 ? m * ldexp(1.0, m - 1) : 0.0;
+    double bytes = states * (sizeof(float) + sizeof(uint8_t)) +
+                   ldexp(1.0, m) * sizeof(uint32_t) + (double)n * n * sizeof(float);
+    // --mem-limit, se menor, também vale para as tabelas
+    int limit_mb = config.dp_mem_mb;
+    if (config.mem_limit_mb > 0 && config.mem_limit_mb < limit_mb) {
+        limit_mb = config.mem_limit_mb;
+    }
+    double limit = limit_mb * 1048576.0;
+    write_log("Estados: %.0f\n", states);
+    write_log("Memória das tabelas: %.2f MB (limite %d MB)\n",
+              bytes / 1048576.0, limit_mb);
+
+    // Recusa instâncias cujas tabelas não cabem no limite (ou nos índices de 32 bits)
+    if (m > 31 || bytes > limit || states > UINT32_MAX) {
+        write_log_at(LOG_ERROR, "Tabelas excedem o limite de memória; instância não resolvida\n");
+        fprintf(stderr, "Programação dinâmica precisa de %.0f MB (limite %d MB); "
+                "use --dp-mem-mb ou outro método\n", bytes / 1048576.0, limit_mb);
+        close_log();
+        return NULL;
+    }
+
+    Solution* sol = (Solution*)malloc(sizeof(Solution));
+    sol->route = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        sol->route[i] = -1;
+    }
+    sol->cost = DBL_MAX;
+    sol->feasible = 0;
+    sol->gap = 100.0;
+    sol->time = 0.0;
+    sol->total_time = 0;
+    sol->optimal = 0;
+    sol->engine = ENGINE_DP;
+    Telemetry* telemetry = telemetry_create(instance_name, ENGINE_DP);
+
+    StopReason stopped = STOP_NONE;
+
+    // Tempo total é o mesmo para toda rota: verifica o poder de KingsLanding
+    int total_time = 0;
+    for (int i = 0; i < n; i++) {
+        total_time += inst->houses[i].min_time;
+    }
+    if (total_time > inst->houses[0].power) {
+        write_log("Tempo total (%d) excede o poder de KingsLanding (%d)\n",
+                  total_time, inst->houses[0].power);
+    } else if (n == 1) {
+        sol->route[0] = 0;
+        sol->cost = calculate_cost(inst, sol->route);
+        sol->feasible = 1;
+    } else {
+        telemetry_phase(telemetry, "tables");
+        DPTables t;
+        t.n = n;
+        t.m = m;
+        uint32_t num_sets = 1u << m;
+        t.offset = (uint32_t*)malloc(num_sets * sizeof(uint32_t));
+        t.cost = (float*)malloc((size_t)states * sizeof(float));
+        t.parent = (uint8_t*)malloc((size_t)states * sizeof(uint8_t));
+        t.arc = (float*)malloc(n * n * sizeof(float));
+        if (!t.offset || !t.cost || !t.parent || !t.arc) {
+            write_log_at(LOG_ERROR, "Memória insuficiente para as tabelas\n");
+            fprintf(stderr, "Memória insuficiente para as tabelas da programação dinâmica\n");
+            free(t.offset);
+            free(t.cost);
+            free(t.parent);
+            free(t.arc);
+            telemetry_finish(telemetry, sol);
+            free_solution(sol);
+            close_log();
+            return NULL;
+        }
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                t.arc[j * n + i] = (float)inst->cost[i * n + j];
+            }
+        }
+
+        // Entradas de S começam depois das entradas de todos os subconjuntos menores (em valor)
+        uint32_t next = 0;
+        for (uint32_t set = 0; set < num_sets; set++) {
+            t.offset[set] = next;
+            next += __builtin_popcount(set);
+        }
+
+        // Camada 1: caminhos KingsLanding -> j
+        for (int bit = 0; bit < m; bit++) {
+            t.cost[t.offset[1u << bit]] = t.arc[(bit + 1) * n];
+            t.parent[t.offset[1u << bit]] = 0;
+        }
+
+        // Camadas seguintes, divididas em faixas contíguas de subconjuntos
+        int num_threads = config.threads > 0 ? config.threads : 1;
+        if ((uint32_t)num_threads > num_sets) {
+            num_threads = (int)num_sets;
+        }
+        telemetry_phase(telemetry, "layers");
+        pthread_t* threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+        DPLayerTask* tasks = (DPLayerTask*)malloc(num_threads * sizeof(DPLayerTask));
+        double sets = m;        // Subconjuntos da camada atual, C(m, size)
+        double computed = m;    // Estados calculados (a camada 1 já está pronta)
+        for (int size = 2; size <= m; size++) {
+            // Sem rota parcial para devolver: uma parada descarta as tabelas
+            stopped = limit_reached(telemetry_elapsed(telemetry), -1);
+            if (stopped != STOP_NONE) {
+                write_log("Interrompida na camada %d de %d: %s\n", size, m,
+                          stop_reason_text(stopped));
+                break;
+            }
+            for (int k = 0; k < num_threads; k++) {
+                tasks[k].t = &t;
+                tasks[k].size = size;
+                tasks[k].first = (uint32_t)((uint64_t)num_sets * k / num_threads);
+                tasks[k].last = (uint32_t)((uint64_t)num_sets * (k + 1) / num_threads);
+            }
+            for (int k = 1; k < num_threads; k++) {
+                pthread_create(&threads[k], NULL, dp_layer, &tasks[k]);
+            }
+            dp_layer(&tasks[0]);
+            for (int k = 1; k < num_threads; k++) {
+                pthread_join(threads[k], NULL);
+            }
+            // C(m, size) subconjuntos com size estados cada
+            sets = sets * (m - size + 1) / size;
+            computed += size * sets;
+        }
+        telemetry_counters(telemetry, (long long)llround(computed), -1, -1);
+        free(threads);
+        free(tasks);
+
+        if (stopped == STOP_NONE) {
+            telemetry_phase(telemetry, "reconstruction");
+            // Fecha o ciclo voltando para KingsLanding
+            uint32_t full = num_sets - 1;
+            const float* full_cost = t.cost + t.offset[full];
+            float best = FLT_MAX;
+            int last = -1;
+            for (int bit = 0; bit < m; bit++) {
+                float value = full_cost[bit] + (float)inst->cost[(bit + 1) * n];
+                if (value < best) {
+                    best = value;
+                    last = bit + 1;
+                }
+            }
+
+            // Reconstrói a rota de trás para frente pelos predecessores
+            uint32_t set = full;
+            int city = last;
+            for (int pos = n - 1; pos >= 1; pos--) {
+                sol->route[pos] = city;
+                int prev = t.parent[t.offset[set] + dp_rank(set, city - 1)];
+                set &= ~(1u << (city - 1));
+                city = prev;
+            }
+            sol->route[0] = 0;
+
+            // Custo final recalculado em double a partir da rota
+            sol->cost = calculate_cost(inst, sol->route);
+            sol->feasible = 1;
+            write_log("Custo da tabela (float): %.2f\n", best + (double)total_time);
+        } else {
+            // Sem tabelas completas, devolve a rota do vizinho mais próximo
+            // (o tempo total já cabe no poder de KingsLanding)
+            nearest_neighbour_tour(inst, sol->route);
+            sol->cost = calculate_cost(inst, sol->route);
+            sol->feasible = 1;
+        }
+
+        free(t.offset);
+        free(t.cost);
+        free(t.parent);
+        free(t.arc);
+    }
+
+    if (sol->feasible) {
+        sol->total_time = total_time;
+    }
+    if (sol->feasible && stopped == STOP_NONE) {
+        sol->gap = 0.0;
+        sol->optimal = 1;
+        portfolio_bound(sol->cost);
+    }
+
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    sol->time = (end_time.tv_sec - start_time.tv_sec) +
+                (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+
+    telemetry_finish(telemetry, sol);
+
+    write_log("\nResultados finais:\n");
+    write_log("Status: %s\n", sol->optimal ? "Solução ótima encontrada" :
+              sol->feasible ? "Solução viável (rota inicial)" : "Sem solução viável");
+    if (stopped != STOP_NONE) {
+        write_log("Parada: %s\n", stop_reason_text(stopped));
+    }
+    write_log("Custo: %.2f\n", sol->cost);
+    write_log("Tempo: %.2f s\n", sol->time);
+    write_log("Gap: %.2f%%\n", sol->gap);
+    write_log("Viável: %s\n", sol->feasible ? "Sim" : "Não");
+
+    if (sol->feasible) {
+        write_log("\nRota encontrada:\n");
+        for (int i = 0; i < n; i++) {
+            write_log("%s ", inst->houses[sol->route[i]].name);
+        }
+        write_log("\n");
+    }
+
+    close_log();
+    return sol;
+}
@@ -0,0 +1,119 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+/**
+ * Gerador de instâncias sintéticas para testes de escala
+ *
+ * Linha de comando do gerador de tsp_synth.c (modelos, reprodutibilidade
+ * pela semente e orçamento de tempo estão descritos lá). Grava a instância
+ * no formato texto ou, com --binary, no formato binário.
+ */
+
+static void print_usage(const char* prog) {
+    printf("Uso: %s [opções] n saida\n", prog);
+    printf("Opções:\n");
+    printf("  --model NOME       Distâncias: uniform, clustered ou asymmetric (padrão uniform)\n");
+    printf("  --seed N           Semente (padrão 1); a mesma semente gera a mesma instância\n");
+    printf("  --clusters K       Agrupamentos do modelo clustered (padrão ~ raiz de n)\n");
+    printf("  --asymmetry F      Acréscimo máximo relativo de um arco no modelo asymmetric "
+           "(padrão 0.5)\n");
+    printf("  --side L           Lado do quadrado das coordenadas (padrão 1000)\n");
+    printf("  --risk R           Risco máximo de um arco, em [0, R] (padrão 0.5; 0 = sem risco)\n");
+    printf("  --min-time T       Tempos mínimos em [1, T] (padrão 10)\n");
+    printf("  --budget NOME      Orçamento de tempo: tight (folga 0) ou loose (folga 1)\n");
+    printf("  --slack F          Orçamento = soma dos tempos mínimos * (1 + F) (padrão 1; "
+           "negativo = inviável)\n");
+    printf("  --binary           Grava no formato binário (ver tsp_convert)\n");
+    printf("  -h, --help         Mostra esta ajuda\n");
+}
+
+int main(int argc, char** argv) {
+    SynthParams g;
+    synth_defaults(&g, 0);
+    int binary = 0;
+
+    static struct option long_options[] = {
+        {"model",      required_argument, 0, 'm'},
+        {"seed",       required_argument, 0, 's'},
+        {"clusters",   required_argument, 0, 'k'},
+        {"asymmetry",  required_argument, 0, 'a'},
+        {"side",       required_argument, 0, 'L'},
+        {"risk",       required_argument, 0, 'r'},
+        {"min-time",   required_argument, 0, 't'},
+        {"budget",     required_argument, 0, 'B'},
+        {"slack",      required_argument, 0, 'S'},
+        {"binary",     no_argument,       0, 'b'},
+        {"help",       no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'm':
+                if (!parse_synth_model(optarg, &g.model)) {
+                    fprintf(stderr, "Modelo desconhecido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 's': g.seed = strtoull(optarg, NULL, 10); break;
+            case 'k':
+                g.clusters = atoi(optarg);
+                if (g.clusters < 1) {
+                    fprintf(stderr, "Número de agrupamentos inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'a': g.asymmetry = atof(optarg); break;
+            case 'L': g.side = atof(optarg); break;
+            case 'r': g.risk_max = atof(optarg); break;
+            case 't':
+                g.max_min_time = atoi(optarg);
+                if (g.max_min_time < 1) {
+                    fprintf(stderr, "Tempo mínimo máximo inválido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'B':
+                if (strcmp(optarg, "tight") == 0) {
+                    g.slack = 0.0;
+                } else if (strcmp(optarg, "loose") == 0) {
+                    g.slack = 1.0;
+                } else {
+                    fprintf(stderr, "Orçamento desconhecido: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'S': g.slack = atof(optarg); break;
+            case 'b': binary = 1; break;
+            case 'h': print_usage(argv[0]); return 0;
+            default:  print_usage(argv[0]); return 1;
+        }
+    }
+
+    if (optind + 2 != argc) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    g.n = atoi(argv[optind]);
+    const char* output = argv[optind + 1];
+    if (g.n < 2 || g.n > MAX_CITIES) {
+        fprintf(stderr, "Número de cidades inválido (2 a %d): %s\n", MAX_CITIES, argv[optind]);
+        return 1;
+    }
+    if (g.side <= 0.0 || g.risk_max < 0.0 || g.asymmetry < 0.0) {
+        fprintf(stderr, "Parâmetros de distância ou risco inválidos\n");
+        return 1;
+    }
+    int budget = 0;
+    int ok = synth_write(&g, output, binary, &budget);
+    if (ok) {
+        printf("%s: %d cidades, modelo %s, semente %llu, orçamento %d (folga %.2f)%s\n",
+               output, g.n, synth_model_name(g.model), g.seed, budget, g.slack,
+               binary ? ", binário" : "");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+/**
+ * Heurísticas primais: construção de rotas e busca local
+ *
+ * As rotas começam sempre em KingsLanding (route[0] = 0). Os custos
+ * devolvidos por estas funções são apenas a soma das arestas; a soma dos
+ * tempos mínimos é a mesma para qualquer rota e é somada por
+ * calculate_cost. Pela mesma razão, o limite de poder de KingsLanding vale
+ * para todas as rotas ou para nenhuma.
+ *
+ * A busca local trata instâncias assimétricas: inverter um trecho no 2-opt
+ * troca o sentido das suas arestas, e a diferença é obtida em O(1) por
+ * somas acumuladas dos dois sentidos ao longo da rota.
+ */
+
+// Menor diferença considerada melhoria (evita ciclos por arredondamento)
+#define HEUR_EPS 1e-9
+
+// Custo das arestas da rota, incluindo o retorno a KingsLanding
+static double tour_edges(const Instance* inst, const int* route) {
+    int n = inst->n;
+    double total = 0.0;
+    for (int i = 0; i < n; i++) {
+        total += inst->cost[route[i] * n + route[(i + 1) % n]];
+    }
+    return total;
+}
+
+// Vizinho mais próximo: a partir de KingsLanding, vai sempre para a cidade
+// não visitada mais barata. Retorna o custo das arestas
+double nearest_neighbour_tour(const Instance* inst, int* route) {
+    int n = inst->n;
+    int* visited = (int*)calloc(n, sizeof(int));
+    route[0] = 0;
+    visited[0] = 1;
+
+    for (int pos = 1; pos < n; pos++) {
+        const double* row = inst->cost + route[pos - 1] * n;
+        int best = -1;
+        for (int j = 1; j < n; j++) {
+            if (!visited[j] && (best < 0 || row[j] < row[best])) {
+                best = j;
+            }
+        }
+        route[pos] = best;
+        visited[best] = 1;
+    }
+
+    free(visited);
+    return tour_edges(inst, route);
+}
+
+// Inserção mais barata: parte do ciclo KingsLanding -> mais próxima -> volta
+// e insere a cada passo a cidade de menor custo de inserção na melhor aresta.
+// Cada cidade guarda sua melhor aresta; só as cidades cuja melhor aresta foi
+// quebrada pela última inserção são reavaliadas por completo. Retorna o
+// custo das arestas
+double cheapest_insertion_tour(const Instance* inst, int* route) {
+    int n = inst->n;
+    const double* c = inst->cost;
+    route[0] = 0;
+    if (n == 1) {
+        return 0.0;
+    }
+
+    int* next = (int*)malloc(n * sizeof(int));          // Sucessor no ciclo
+    int* in_tour = (int*)calloc(n, sizeof(int));
+    int* best_after = (int*)malloc(n * sizeof(int));    // Melhor aresta: best_after -> next
+    double* best_cost = (double*)malloc(n * sizeof(double));
+
+    // Ciclo inicial com a cidade mais barata de visitar e voltar
+    int first = 1;
+    for (int j = 2; j < n; j++) {
+        if (c[j] + c[j * n] < c[first] + c[first * n]) {
+            first = j;
+        }
+    }
+    next[0] = first;
+    next[first] = 0;
+    in_tour[0] = in_tour[first] = 1;
+
+    // Melhor aresta de cada cidade no ciclo inicial
+    for (int k = 1; k < n; k++) {
+        if (in_tour[k]) continue;
+        double a = c[k] + c[k * n + first] - c[first];
+        double b = c[first * n + k] + c[k * n] - c[first * n];
+        best_after[k] = a <= b ? 0 : first;
+        best_cost[k] = a <= b ? a : b;
+    }
+
+    for (int inserted = 2; inserted < n; inserted++) {
+        // Cidade de menor custo de inserção
+        int k = -1;
+        for (int j = 1; j < n; j++) {
+            if (!in_tour[j] && (k < 0 || best_cost[j] < best_cost[k])) {
+                k = j;
+            }
+        }
+        int u = best_after[k];
+        int v = next[u];
+        next[u] = k;
+        next[k] = v;
+        in_tour[k] = 1;
+
+        // Atualiza as melhores arestas: (u, v) saiu, (u, k) e (k, v) entraram
+        for (int j = 1; j < n; j++) {
+            if (in_tour[j]) continue;
+            if (best_after[j] == u) {
+                // A melhor aresta foi quebrada: percorre o ciclo inteiro
+                best_cost[j] = DBL_MAX;
+                int a = 0;
+                do {
+                    int b = next[a];
+                    double delta = c[a * n + j] + c[j * n + b] - c[a * n + b];
+                    if (delta < best_cost[j]) {
+                        best_cost[j] = delta;
+                        best_after[j] = a;
+                    }
+                    a = b;
+                } while (a != 0);
+            } else {
+                double du = c[u * n + j] + c[j * n + k] - c[u * n + k];
+                double dk = c[k * n + j] + c[j * n + v] - c[k * n + v];
+                if (du < best_cost[j]) {
+                    best_cost[j] = du;
+                    best_after[j] = u;
+                }
+                if (dk < best_cost[j]) {
+                    best_cost[j] = dk;
+                    best_after[j] = k;
+                }
+            }
+        }
+    }
+
+    // Converte o ciclo para vetor começando em KingsLanding
+    int city = 0;
+    for (int pos = 0; pos < n; pos++) {
+        route[pos] = city;
+        city = next[city];
+    }
+
+    free(next);
+    free(in_tour);
+    free(best_after);
+    free(best_cost);
+    return tour_edges(inst, route);
+}
+
+// Somas acumuladas das arestas da rota nos dois sentidos:
+// fwd[k] = Σ c[r_t][r_t+1] e bwd[k] = Σ c[r_t+1][r_t] para t < k
+static void tour_prefix(const Instance* inst, const int* route, double* fwd, double* bwd) {
+    int n = inst->n;
+    fwd[0] = bwd[0] = 0.0;
+    for (int k = 1; k < n; k++) {
+        fwd[k] = fwd[k - 1] + inst->cost[route[k - 1] * n + route[k]];
+        bwd[k] = bwd[k - 1] + inst->cost[route[k] * n + route[k - 1]];
+    }
+}
+
+// 2-opt: inverte o trecho route[i+1..j] sempre que isso reduz o custo.
+// A diferença de custo de cada movimento sai em O(1) das somas acumuladas;
+// elas são refeitas (O(n)) só quando um movimento é aplicado.
+// Retorna o custo das arestas da rota final
+double two_opt(const Instance* inst, int* route) {
+    int n = inst->n;
+    const double* c = inst->cost;
+    if (n < 4) {
+        return tour_edges(inst, route);
+    }
+    double* fwd = (double*)malloc(n * sizeof(double));
+    double* bwd = (double*)malloc(n * sizeof(double));
+    tour_prefix(inst, route, fwd, bwd);
+
+    int improved = 1;
+    while (improved) {
+        improved = 0;
+        for (int i = 0; i < n - 2; i++) {
+            int a = route[i];
+            int s = route[i + 1];
+            for (int j = i + 2; j < n; j++) {
+                int e = route[j];
+                int b = route[(j + 1) % n];
+                double delta = c[a * n + e] + c[s * n + b] - c[a * n + s] - c[e * n + b] +
+                               (bwd[j] - bwd[i + 1]) - (fwd[j] - fwd[i + 1]);
+                if (delta < -HEUR_EPS) {
+                    for (int l = i + 1, r = j; l < r; l++, r--) {
+                        int tmp = route[l];
+                        route[l] = route[r];
+                        route[r] = tmp;
+                    }
+                    tour_prefix(inst, route, fwd, bwd);
+                    s = route[i + 1];
+                    improved = 1;
+                }
+            }
+        }
+    }
+
+    free(fwd);
+    free(bwd);
+    return tour_edges(inst, route);
+}
+
+// Or-opt: move trechos de 1 a 3 cidades consecutivas para outra aresta da
+// rota, mantendo o sentido. Remoção e inserção custam O(1) cada.
+// Retorna o custo das arestas da rota final
+double or_opt(const Instance* inst, int* route) {
+    int n = inst->n;
+    const double* c = inst->cost;
+    if (n < 4) {
+        return tour_edges(inst, route);
+    }
+    int* buffer = (int*)malloc(n * sizeof(int));
+
+    int improved = 1;
+    while (improved) {
+        improved = 0;
+        for (int len = 1; len <= 3 && len <= n - 3; len++) {
+            for (int s = 1; s + len - 1 < n; s++) {
+                int e = s + len - 1;
+                int p = route[s - 1];
+                int q = route[(e + 1) % n];
+                int first = route[s];
+                int last = route[e];
+                double removal = c[p * n + first] + c[last * n + q] - c[p * n + q];
+
+                // Melhor aresta (route[k], route[k+1]) fora do trecho
+                double best = -HEUR_EPS;
+                int best_k = -1;
+                for (int k = 0; k < n; k++) {
+                    if (k >= s - 1 && k <= e) continue;
+                    int u = route[k];
+                    int v = route[(k + 1) % n];
+                    double delta = c[u * n + first] + c[last * n + v] - c[u * n + v] - removal;
+                    if (delta < best) {
+                        best = delta;
+                        best_k = k;
+                    }
+                }
+                if (best_k < 0) continue;
+
+                // Reconstrói a rota com o trecho logo após route[best_k]
+                int m = 0;
+                for (int k = 0; k < n; k++) {
+                    if (k >= s && k <= e) continue;
+                    buffer[m++] = route[k];
+                    if (k == best_k) {
+                        for (int t = s; t <= e; t++) {
+                            buffer[m++] = route[t];
+                        }
+                    }
+                }
+                memcpy(route, buffer, n * sizeof(int));
+                improved = 1;
+            }
+        }
+    }
+
+    free(buffer);
+    return tour_edges(inst, route);
+}
+
+// Alterna 2-opt e Or-opt até nenhum dos dois melhorar a rota
+double local_search(const Instance* inst, int* route) {
+    double cost = tour_edges(inst, route);
+    while (1) {
+        two_opt(inst, route);
+        double improved = or_opt(inst, route);
+        if (improved >= cost - HEUR_EPS) {
+            return improved;
+        }
+        cost = improved;
+    }
+}
+
+// Melhor rota entre vizinho mais próximo e inserção mais barata, ambas
+// refinadas por busca local. Preenche route e cost (no mesmo critério de
+// calculate_cost) e retorna 0 se nenhuma rota respeita o poder de KingsLanding
+int heuristic_tour(const Instance* inst, int* route, double* cost) {
+    int n = inst->n;
+    int total_time = 0;
+    for (int i = 0; i < n; i++) {
+        total_time += inst->houses[i].min_time;
+    }
+    if (total_time > inst->houses[0].power) {
+        return 0;
+    }
+
+    int* other = (int*)malloc(n * sizeof(int));
+    nearest_neighbour_tour(inst, route);
+    double best = local_search(inst, route);
+    cheapest_insertion_tour(inst, other);
+    double value = local_search(inst, other);
+    if (value < best) {
+        memcpy(route, other, n * sizeof(int));
+    }
+    free(other);
+
+    *cost = calculate_cost(inst, route);
+    return 1;
+}
@@ -0,0 +1,220 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+/**
+ * Limite inferior de Held-Karp (1-árvore com penalidades lagrangianas)
+ *
+ * O caminho parcial fixo (de KingsLanding até a cidade atual) é contraído em
+ * um único vértice especial s. Completar a rota equivale a um ciclo
+ * hamiltoniano sobre {s} ∪ U, onde U são as cidades não visitadas:
+ * - s liga-se a duas cidades distintas de U: atual -> j e j' -> KingsLanding
+ * - as demais |U|-1 arestas formam um caminho em U, logo custam ao menos
+ *   uma árvore geradora mínima de U com custo min(c[a][b], c[b][a])
+ *
+ * Penalidades pi[j] são somadas às arestas incidentes em j e descontadas
+ * (2 * Σ pi[j]) do total; para qualquer pi o valor continua sendo um limite
+ * inferior. O método do subgradiente ajusta pi para maximizar o limite,
+ * empurrando o grau de cada vértice da 1-árvore em direção a 2.
+ */
+
+// Cria área de trabalho para instâncias com n cidades
+HKWorkspace* hk_workspace_create(int n) {
+    HKWorkspace* ws = (HKWorkspace*)malloc(sizeof(HKWorkspace));
+    ws->n = n;
+    ws->cities = (int*)malloc(n * sizeof(int));
+    ws->degree = (int*)malloc(n * sizeof(int));
+    ws->parent = (int*)malloc(n * sizeof(int));
+    ws->in_tree = (int*)malloc(n * sizeof(int));
+    ws->key = (double*)malloc(n * sizeof(double));
+    ws->best_pi = (double*)malloc(n * sizeof(double));
+    return ws;
+}
+
+// Libera área de trabalho
+void hk_workspace_free(HKWorkspace* ws) {
+    if (!ws) return;
+    free(ws->cities);
+    free(ws->degree);
+    free(ws->parent);
+    free(ws->in_tree);
+    free(ws->key);
+    free(ws->best_pi);
+    free(ws);
+}
+
+// Avalia a 1-árvore para as penalidades atuais e preenche os graus.
+// Retorna o valor lagrangiano L(pi)
+static double one_tree(const Instance* inst, HKWorkspace* ws, int k,
+                       int current, const double* pi) {
+    int n = inst->n;
+    const double* c = inst->cost;
+    int* cities = ws->cities;
+    double total = 0.0;
+
+    for (int a = 0; a < k; a++) {
+        ws->degree[a] = 0;
+        ws->in_tree[a] = 0;
+        ws->key[a] = DBL_MAX;
+        ws->parent[a] = -1;
+    }
+
+    // Árvore geradora mínima de U (Prim em O(k²))
+    ws->key[0] = 0.0;
+    for (int step = 0; step < k; step++) {
+        int best = -1;
+        for (int a = 0; a < k; a++) {
+            if (!ws->in_tree[a] && (best < 0 || ws->key[a] < ws->key[best])) {
+                best = a;
+            }
+        }
+        ws->in_tree[best] = 1;
+        total += ws->key[best];
+        if (ws->parent[best] >= 0) {
+            ws->degree[best]++;
+            ws->degree[ws->parent[best]]++;
+        }
+
+        int u = cities[best];
+        for (int a = 0; a < k; a++) {
+            if (!ws->in_tree[a]) {
+                int v = cities[a];
+                double cuv = c[u * n + v];
+                double cvu = c[v * n + u];
+                double w = (cuv < cvu ? cuv : cvu) + pi[u] + pi[v];
+                if (w < ws->key[a]) {
+                    ws->key[a] = w;
+                    ws->parent[a] = best;
+                }
+            }
+        }
+    }
+
+    // Arestas do vértice especial: atual -> j e j' -> KingsLanding, j != j'
+    int out1 = -1, out2 = -1, in1 = -1, in2 = -1;
+    double out1_cost = DBL_MAX, out2_cost = DBL_MAX;
+    double in1_cost = DBL_MAX, in2_cost = DBL_MAX;
+    for (int a = 0; a < k; a++) {
+        int v = cities[a];
+        double out = c[current * n + v] + pi[v];
+        double in = c[v * n] + pi[v];
+        if (out < out1_cost) {
+            out2 = out1; out2_cost = out1_cost;
+            out1 = a; out1_cost = out;
+        } else if (out < out2_cost) {
+            out2 = a; out2_cost = out;
+        }
+        if (in < in1_cost) {
+            in2 = in1; in2_cost = in1_cost;
+            in1 = a; in1_cost = in;
+        } else if (in < in2_cost) {
+            in2 = a; in2_cost = in;
+        }
+    }
+
+    // Se a melhor saída e a melhor entrada coincidem, troca a mais barata
+    int out_sel = out1, in_sel = in1;
+    double s_cost = out1_cost + in1_cost;
+    if (out1 == in1) {
+        if (out1_cost + in2_cost <= out2_cost + in1_cost) {
+            in_sel = in2;
+            s_cost = out1_cost + in2_cost;
+        } else {
+            out_sel = out2;
+            s_cost = out2_cost + in1_cost;
+        }
+    }
+    total += s_cost;
+    ws->degree[out_sel]++;
+    ws->degree[in_sel]++;
+
+    // Desconta as penalidades (cada vértice de uma rota tem grau 2)
+    for (int a = 0; a < k; a++) {
+        total -= 2.0 * pi[cities[a]];
+    }
+    return total;
+}
+
+/**
+ * Calcula limite inferior para o custo das arestas que faltam para completar a
+ * rota: sair de current, visitar todas as cidades com visited[i] == 0 e voltar
+ * para KingsLanding. Os tempos mínimos não são incluídos.
+ *
+ * pi (indexado por cidade) é usado como ponto de partida e recebe as
+ * penalidades que geraram o melhor limite, para aquecer os nós filhos.
+ * target é o valor a partir do qual o nó seria podado (DBL_MAX se não há
+ * incumbente): a otimização para assim que o limite o atinge.
+ */
+double held_karp_bound(const Instance* inst, HKWorkspace* ws, const int* visited,
+                       int current, double* pi, int max_iter, double target) {
+    int n = inst->n;
+    const double* c = inst->cost;
+
+    // Monta a lista de cidades não visitadas
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        if (!visited[i]) {
+            ws->cities[k++] = i;
+        }
+    }
+
+    // Casos triviais: o limite é o próprio custo de completar a rota
+    if (k == 0) {
+        return c[current * n];
+    }
+    if (k == 1) {
+        return c[current * n + ws->cities[0]] + c[ws->cities[0] * n];
+    }
+
+    double best = -DBL_MAX;
+    double lambda = 2.0;
+    int no_improve = 0;
+    int patience = max_iter / 10 > 2 ? max_iter / 10 : 2;
+
+    for (int iter = 0; iter <= max_iter; iter++) {
+        double value = one_tree(inst, ws, k, current, pi);
+
+        if (value > best + 1e-9) {
+            best = value;
+            no_improve = 0;
+            for (int a = 0; a < k; a++) {
+                ws->best_pi[ws->cities[a]] = pi[ws->cities[a]];
+            }
+        } else if (++no_improve >= patience) {
+            lambda /= 2.0;
+            no_improve = 0;
+        }
+
+        // Subgradiente: g[j] = grau(j) - 2
+        int norm = 0;
+        for (int a = 0; a < k; a++) {
+            int g = ws->degree[a] - 2;
+            norm += g * g;
+        }
+
+        // 1-árvore é uma rota (limite exato) ou o nó já pode ser podado
+        if (norm == 0 || best >= target || iter == max_iter || lambda < 1e-6) {
+            break;
+        }
+
+        // Passo de Polyak; sem incumbente usa uma estimativa acima do limite
+        double goal = (target < DBL_MAX) ? target : best + 0.05 * (best > 0 ? best : 1.0);
+        if (goal <= value) {
+            goal = value + 0.01 * (value > 0 ? value : 1.0);
+        }
+        double step = lambda * (goal - value) / norm;
+        for (int a = 0; a < k; a++) {
+            pi[ws->cities[a]] += step * (ws->degree[a] - 2);
+        }
+    }
+
+    // Devolve as penalidades da melhor iteração para aquecer os filhos
+    for (int a = 0; a < k; a++) {
+        pi[ws->cities[a]] = ws->best_pi[ws->cities[a]];
+    }
+
+    // Margem contra erros de arredondamento na soma
+    return best - 1e-7 * (best > 1.0 ? best : 1.0);
+}
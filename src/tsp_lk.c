@@ -0,0 +1,564 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <time.h>
+
+/**
+ * Heurística de busca local iterada no estilo Lin-Kernighan para instâncias
+ * grandes (centenas a milhares de cidades)
+ *
+ * - Listas de candidatos: para cada cidade, as k cidades de menor custo.
+ *   Só arestas para candidatos são consideradas nos movimentos
+ * - Movimentos: 2-opt e Or-opt (trechos de 1 a 3 cidades, nos dois
+ *   sentidos) sobre a rota em vetor com posição inversa
+ * - Bits "don't look": uma fila guarda as cidades ativas; a cidade sai da
+ *   fila quando nenhum movimento a partir dela melhora a rota e volta quando
+ *   uma aresta vizinha muda
+ * - Perturbação: double-bridge local (troca de dois trechos curtos vizinhos)
+ *   seguida de busca local a partir das 8 pontas, até o tempo limite.
+ *   As alterações de cada perturbação ficam em um diário; se a rota piora,
+ *   o diário é desfeito em vez de copiar a rota inteira
+ *
+ * Em instâncias assimétricas inverter um trecho muda o custo das suas
+ * arestas internas; nesse caso só são usados movimentos que preservam o
+ * sentido (Or-opt direto e double-bridge).
+ */
+
+// Menor diferença considerada melhoria
+#define LK_EPS 1e-9
+
+// Tamanho máximo de cada trecho trocado pelo double-bridge
+#define LK_KICK_SEGMENT 50
+
+// Cidades processadas entre duas verificações dos limites de parada
+#define LK_CHECK_INTERVAL 256
+
+// Escrita registrada no diário: posição e cidade anterior
+typedef struct {
+    int pos;
+    int city;
+} LKJournalEntry;
+
+// Estado da busca local
+typedef struct {
+    const Instance* inst;
+    int n;
+    const double* c;
+    int symmetric;          // c[i][j] == c[j][i] para todo par
+    int* tour;              // Cidade em cada posição
+    int* pos;               // Posição de cada cidade
+    int* neigh;             // Candidatos: neigh[i * k .. i * k + k - 1]
+    int k;                  // Candidatos por cidade
+    int* queue;             // Fila circular de cidades ativas
+    int* in_queue;          // Cidade está na fila (bit "don't look" desligado)
+    int qhead, qsize;
+    LKJournalEntry* journal;// Escritas desde o início da perturbação
+    int journal_size;
+    int journal_capacity;
+    int journaling;         // Registra as escritas em tour
+    double cost;            // Custo das arestas da rota atual
+    unsigned int rng;
+    Telemetry* telemetry;   // Relógio da busca
+    StopReason stop;        // Limite atingido (a busca para assim que possível)
+    int checks;
+} LKState;
+
+// Custo do arco i -> j
+static inline double lk_cost(const LKState* s, int i, int j) {
+    return s->c[(size_t)i * s->n + j];
+}
+
+static inline int lk_succ(const LKState* s, int city) {
+    int p = s->pos[city] + 1;
+    return s->tour[p == s->n ? 0 : p];
+}
+
+static inline int lk_pred(const LKState* s, int city) {
+    int p = s->pos[city];
+    return s->tour[p == 0 ? s->n - 1 : p - 1];
+}
+
+// Verifica os limites de parada a cada LK_CHECK_INTERVAL chamadas
+static int lk_stopped(LKState* s) {
+    if (s->stop == STOP_NONE && ++s->checks % LK_CHECK_INTERVAL == 0) {
+        s->stop = limit_reached(telemetry_elapsed(s->telemetry), -1);
+    }
+    return s->stop != STOP_NONE;
+}
+
+// Escreve city na posição p, registrando o valor anterior se necessário
+static void lk_set(LKState* s, int p, int city) {
+    if (s->journaling) {
+        if (s->journal_size == s->journal_capacity) {
+            s->journal_capacity *= 2;
+            s->journal = (LKJournalEntry*)realloc(s->journal,
+                                                  s->journal_capacity * sizeof(LKJournalEntry));
+        }
+        s->journal[s->journal_size].pos = p;
+        s->journal[s->journal_size].city = s->tour[p];
+        s->journal_size++;
+    }
+    s->tour[p] = city;
+    s->pos[city] = p;
+}
+
+// Inverte exatamente as posições i..j (sentido direto, com volta circular)
+static void lk_reverse_positions(LKState* s, int i, int j) {
+    int n = s->n;
+    int len = (j - i + n) % n + 1;
+    for (int t = 0; t < len / 2; t++) {
+        int a = s->tour[i];
+        int b = s->tour[j];
+        lk_set(s, i, b);
+        lk_set(s, j, a);
+        i = (i + 1 == n) ? 0 : i + 1;
+        j = (j == 0) ? n - 1 : j - 1;
+    }
+}
+
+// Inverte o caminho from..to da rota. Com custos simétricos inverter o
+// complemento produz a mesma rota (no sentido oposto): usa o lado mais curto
+static void lk_reverse_path(LKState* s, int from, int to) {
+    int n = s->n;
+    int i = s->pos[from];
+    int j = s->pos[to];
+    int len = (j - i + n) % n + 1;
+    if (s->symmetric && 2 * len > n && len < n) {
+        lk_reverse_positions(s, (j + 1) % n, (i - 1 + n) % n);
+    } else {
+        lk_reverse_positions(s, i, j);
+    }
+}
+
+// Move o trecho nas posições i..j para logo depois da posição t (fora do
+// trecho), preservando o sentido. Implementado como rotação por três
+// inversões do bloco mais curto entre o trecho e o destino
+static void lk_move_segment(LKState* s, int i, int j, int t) {
+    int n = s->n;
+    int after = (t - j + n) % n;            // Distância do fim do trecho até t
+    int before = (i - t - 1 + n) % n;       // Cidades entre t e o trecho
+    if (after <= before) {
+        // [i..j][j+1..t] -> [j+1..t][i..j]
+        lk_reverse_positions(s, i, j);
+        lk_reverse_positions(s, (j + 1) % n, t);
+        lk_reverse_positions(s, i, t);
+    } else {
+        // [t+1..i-1][i..j] -> [i..j][t+1..i-1]
+        int start = (t + 1) % n;
+        lk_reverse_positions(s, start, (i - 1 + n) % n);
+        lk_reverse_positions(s, i, j);
+        lk_reverse_positions(s, start, j);
+    }
+}
+
+// Reativa a cidade (desliga o bit "don't look")
+static void lk_push(LKState* s, int city) {
+    if (s->in_queue[city]) return;
+    s->in_queue[city] = 1;
+    s->queue[(s->qhead + s->qsize) % s->n] = city;
+    s->qsize++;
+}
+
+static int lk_pop(LKState* s) {
+    int city = s->queue[s->qhead];
+    s->qhead = (s->qhead + 1) % s->n;
+    s->qsize--;
+    s->in_queue[city] = 0;
+    return city;
+}
+
+// Monta as listas com os k candidatos mais baratos de cada cidade. Se um
+// limite é atingido as listas ficam incompletas (s->stop indica a parada)
+static void lk_build_neighbours(LKState* s) {
+    int n = s->n;
+    int k = s->k;
+    double* key = (double*)malloc(k * sizeof(double));
+    for (int i = 0; i < n && !lk_stopped(s); i++) {
+        int* list = s->neigh + (size_t)i * k;
+        int size = 0;
+        for (int j = 0; j < n; j++) {
+            if (j == i) continue;
+            double value = lk_cost(s, i, j);
+            if (size == k && value >= key[k - 1]) continue;
+            int p = size < k ? size++ : k - 1;
+            while (p > 0 && key[p - 1] > value) {
+                key[p] = key[p - 1];
+                list[p] = list[p - 1];
+                p--;
+            }
+            key[p] = value;
+            list[p] = j;
+        }
+    }
+    free(key);
+}
+
+// Tenta um 2-opt que crie o arco a -> c para um candidato c.
+// Retorna 1 se aplicou um movimento de melhoria
+static int lk_try_two_opt(LKState* s, int a) {
+    if (!s->symmetric) return 0;
+    int* list = s->neigh + (size_t)a * s->k;
+
+    // Sucessor: a b ... c d -> a c ... b d
+    int b = lk_succ(s, a);
+    double g1 = lk_cost(s, a, b);
+    for (int t = 0; t < s->k; t++) {
+        int c = list[t];
+        double ac = lk_cost(s, a, c);
+        if (ac >= g1 - LK_EPS) break;
+        int d = lk_succ(s, c);
+        if (c == b || d == a) continue;
+        double delta = ac + lk_cost(s, b, d) - g1 - lk_cost(s, c, d);
+        if (delta < -LK_EPS) {
+            lk_reverse_path(s, b, c);
+            s->cost += delta;
+            lk_push(s, a); lk_push(s, b); lk_push(s, c); lk_push(s, d);
+            return 1;
+        }
+    }
+
+    // Predecessor: p a ... e c -> p e ... a c
+    int p = lk_pred(s, a);
+    g1 = lk_cost(s, p, a);
+    for (int t = 0; t < s->k; t++) {
+        int c = list[t];
+        double ac = lk_cost(s, a, c);
+        if (ac >= g1 - LK_EPS) break;
+        int e = lk_pred(s, c);
+        if (c == p || e == a) continue;
+        double delta = ac + lk_cost(s, p, e) - g1 - lk_cost(s, e, c);
+        if (delta < -LK_EPS) {
+            lk_reverse_path(s, a, e);
+            s->cost += delta;
+            lk_push(s, a); lk_push(s, p); lk_push(s, c); lk_push(s, e);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Tenta mover um trecho de 1 a 3 cidades que começa ou termina em a para
+// uma aresta (pc, c) ou (c, sc) de um candidato c, mantendo o sentido do
+// trecho ou, se os custos são simétricos, invertendo-o.
+// Retorna 1 se aplicou um movimento de melhoria
+static int lk_try_or_opt(LKState* s, int a) {
+    int n = s->n;
+    int* list = s->neigh + (size_t)a * s->k;
+
+    for (int len = 1; len <= 3 && len <= n - 3; len++) {
+        for (int side = 0; side < (len > 1 ? 2 : 1); side++) {
+            int i = side == 0 ? s->pos[a] : (s->pos[a] - len + 1 + n) % n;
+            int j = (i + len - 1) % n;
+            int f = s->tour[i];
+            int l = s->tour[j];
+            int p = lk_pred(s, f);
+            int q = lk_succ(s, l);
+            double removal = lk_cost(s, p, f) + lk_cost(s, l, q) - lk_cost(s, p, q);
+            if (removal <= LK_EPS) continue;
+
+            for (int t = 0; t < s->k; t++) {
+                int c = list[t];
+                if (lk_cost(s, a, c) >= removal && lk_cost(s, c, a) >= removal) break;
+                if ((s->pos[c] - i + n) % n < len) continue;
+
+                // Destinos: depois de c (aresta c -> sc) ou antes de c (pc -> c)
+                for (int before = 0; before < 2; before++) {
+                    if (before ? c == q : c == p) continue;
+                    int u = before ? lk_pred(s, c) : c;
+                    int v = before ? c : lk_succ(s, c);
+                    double base = lk_cost(s, u, v) + removal;
+
+                    // Mesmo sentido (u f ... l v) ou invertido (u l ... f v)
+                    for (int reversed = 0; reversed <= s->symmetric; reversed++) {
+                        int head = reversed ? l : f;
+                        int tail = reversed ? f : l;
+                        double delta = lk_cost(s, u, head) + lk_cost(s, tail, v) - base;
+                        if (delta < -LK_EPS) {
+                            lk_move_segment(s, i, j, s->pos[u]);
+                            if (reversed) {
+                                lk_reverse_positions(s, s->pos[f], s->pos[l]);
+                            }
+                            s->cost += delta;
+                            lk_push(s, f); lk_push(s, l); lk_push(s, p);
+                            lk_push(s, q); lk_push(s, u); lk_push(s, v);
+                            return 1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Aplica movimentos de melhoria até esvaziar a fila de cidades ativas ou
+// atingir um limite; cada movimento é completo, então a rota segue válida
+static void lk_local_search(LKState* s) {
+    while (s->qsize > 0 && !lk_stopped(s)) {
+        int a = lk_pop(s);
+        while (lk_try_two_opt(s, a) || lk_try_or_opt(s, a)) {
+            // Continua a partir da mesma cidade enquanto houver melhoria
+        }
+    }
+}
+
+// Double-bridge local: A B C D -> A C B D com B e C curtos e consecutivos.
+// Preserva o sentido de todos os trechos; retorna a variação de custo
+static double lk_double_bridge(LKState* s) {
+    int n = s->n;
+    int max_len = n / 4 < LK_KICK_SEGMENT ? n / 4 : LK_KICK_SEGMENT;
+    int i = rand_r(&s->rng) % n;                    // Início de B
+    int l1 = 1 + rand_r(&s->rng) % max_len;
+    int l2 = 1 + rand_r(&s->rng) % max_len;
+    int j = (i + l1 - 1) % n;                       // Fim de B
+    int m = (j + l2) % n;                           // Fim de C
+
+    int a = s->tour[(i - 1 + n) % n];
+    int b1 = s->tour[i], b2 = s->tour[j];
+    int c1 = s->tour[(j + 1) % n], c2 = s->tour[m];
+    int d = s->tour[(m + 1) % n];
+    double delta = lk_cost(s, a, c1) + lk_cost(s, c2, b1) + lk_cost(s, b2, d) -
+                   lk_cost(s, a, b1) - lk_cost(s, b2, c1) - lk_cost(s, c2, d);
+
+    lk_move_segment(s, i, j, m);
+    s->cost += delta;
+    lk_push(s, a); lk_push(s, b1); lk_push(s, b2);
+    lk_push(s, c1); lk_push(s, c2); lk_push(s, d);
+    return delta;
+}
+
+// Desfaz as escritas registradas desde o início da perturbação
+static void lk_undo(LKState* s) {
+    for (int t = s->journal_size - 1; t >= 0; t--) {
+        int p = s->journal[t].pos;
+        int city = s->journal[t].city;
+        s->tour[p] = city;
+        s->pos[city] = p;
+    }
+    s->journal_size = 0;
+}
+
+// Limite inferior simples: menor saída de cada cidade mais os tempos mínimos
+static double lk_lower_bound(const Instance* inst) {
+    int n = inst->n;
+    double bound = 0.0;
+    for (int i = 0; i < n; i++) {
+        double best = DBL_MAX;
+        for (int j = 0; j < n; j++) {
+            if (j != i && inst->cost[(size_t)i * n + j] < best) {
+                best = inst->cost[(size_t)i * n + j];
+            }
+        }
+        bound += (n > 1 ? best : 0.0) + inst->houses[i].min_time;
+    }
+    return bound;
+}
+
+// Publica a rota atual no portfólio, começando em KingsLanding (route é
+// área de trabalho com n posições)
+static void lk_offer(const LKState* s, int* route) {
+    if (!portfolio_current()) return;
+    int start = s->pos[0];
+    for (int p = 0; p < s->n; p++) {
+        route[p] = s->tour[(start + p) % s->n];
+    }
+    portfolio_offer(route, calculate_cost(s->inst, route));
+}
+
+// Resolve TSP usando a heurística de busca local iterada
+Solution* solve_lk(const Instance* inst, const char* nome_arquivo) {
+    int n = inst->n;
+
+    // Nome base do arquivo, sem o caminho e sem a extensão
+    char instance_name[256];
+    instance_base_name(nome_arquivo, instance_name, sizeof(instance_name));
+
+    // Cria nome do arquivo de log
+    char log_filename[300];
+    snprintf(log_filename, sizeof(log_filename), "logs/%s_LK.log", instance_name);
+    open_log(log_filename);
+
+    struct timespec start_time, now;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    write_log("=== Busca local iterada (Lin-Kernighan) para TSP ===\n");
+    write_log("Instância: %s\n", instance_name);
+    write_log("Método: LK\n");
+    write_log("Número de cidades: %d\n\n", n);
+
+    Solution* sol = (Solution*)malloc(sizeof(Solution));
+    sol->route = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        sol->route[i] = -1;
+    }
+    sol->cost = DBL_MAX;
+    sol->feasible = 0;
+    sol->gap = 100.0;
+    sol->time = 0.0;
+    sol->total_time = 0;
+    sol->optimal = 0;
+    sol->engine = ENGINE_LK;
+    Telemetry* telemetry = telemetry_create(instance_name, ENGINE_LK);
+
+    // Tempo total é o mesmo para toda rota: verifica o poder de KingsLanding
+    int total_time = 0;
+    for (int i = 0; i < n; i++) {
+        total_time += inst->houses[i].min_time;
+    }
+    if (total_time > inst->houses[0].power) {
+        write_log("Tempo total (%d) excede o poder de KingsLanding (%d)\n",
+                  total_time, inst->houses[0].power);
+    } else if (n < 5) {
+        // Instâncias mínimas: a rota heurística já é ótima ou quase
+        double cost;
+        heuristic_tour(inst, sol->route, &cost);
+        sol->cost = cost;
+        sol->feasible = 1;
+    } else {
+        telemetry_phase(telemetry, "construction");
+        LKState s;
+        s.inst = inst;
+        s.n = n;
+        s.c = inst->cost;
+        s.k = config.lk_neighbours < n - 1 ? config.lk_neighbours : n - 1;
+        s.tour = (int*)malloc(n * sizeof(int));
+        s.pos = (int*)malloc(n * sizeof(int));
+        s.neigh = (int*)malloc((size_t)n * s.k * sizeof(int));
+        s.queue = (int*)malloc(n * sizeof(int));
+        s.in_queue = (int*)calloc(n, sizeof(int));
+        s.qhead = s.qsize = 0;
+        s.journal_capacity = 1024;
+        s.journal = (LKJournalEntry*)malloc(s.journal_capacity * sizeof(LKJournalEntry));
+        s.journal_size = 0;
+        s.journaling = 0;
+        s.rng = 12345u;
+        s.telemetry = telemetry;
+        s.stop = STOP_NONE;
+        s.checks = 0;
+
+        s.symmetric = 1;
+        for (int i = 0; i < n && s.symmetric; i++) {
+            for (int j = i + 1; j < n; j++) {
+                if (fabs(s.c[(size_t)i * n + j] - s.c[(size_t)j * n + i]) > LK_EPS) {
+                    s.symmetric = 0;
+                    break;
+                }
+            }
+        }
+        lk_build_neighbours(&s);
+
+        // Rota inicial por vizinho mais próximo, refinada pela busca local
+        s.cost = nearest_neighbour_tour(inst, s.tour);
+        for (int p = 0; p < n; p++) {
+            s.pos[s.tour[p]] = p;
+            lk_push(&s, s.tour[p]);
+        }
+        write_log("Custos simétricos: %s\n", s.symmetric ? "Sim" : "Não");
+        write_log("Candidatos por cidade: %d\n", s.k);
+        write_log("Vizinho mais próximo: %.2f\n", s.cost + total_time);
+        telemetry_point(telemetry, s.cost + total_time, -DBL_MAX);
+        if (s.stop != STOP_NONE) {
+            // Listas de candidatos incompletas: fica a rota do vizinho mais próximo
+            write_log("Listas de candidatos interrompidas: %s\n", stop_reason_text(s.stop));
+        } else {
+            telemetry_phase(telemetry, "local_search");
+            lk_local_search(&s);
+            if (s.stop != STOP_NONE) {
+                write_log("Busca local interrompida: %s\n", stop_reason_text(s.stop));
+            }
+            write_log("Após busca local: %.2f\n", s.cost + total_time);
+            telemetry_point(telemetry, s.cost + total_time, -DBL_MAX);
+        }
+        lk_offer(&s, sol->route);
+        telemetry_phase(telemetry, "perturbation");
+
+        // Perturbações até o tempo limite; pioras são desfeitas pelo diário
+        long long kicks = 0, accepted = 0;
+        double elapsed = 0.0;
+        double next_report = config.progress_interval;
+        s.journaling = 1;
+        while (s.stop == STOP_NONE) {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            elapsed = (now.tv_sec - start_time.tv_sec) + (now.tv_nsec - start_time.tv_nsec) / 1e9;
+            if (elapsed >= config.lk_time) break;
+            s.stop = limit_reached(elapsed, -1);
+            if (s.stop != STOP_NONE) {
+                write_log("Perturbações encerradas: %s\n", stop_reason_text(s.stop));
+                break;
+            }
+
+            double before = s.cost;
+            s.journal_size = 0;
+            lk_double_bridge(&s);
+            lk_local_search(&s);
+            kicks++;
+            if (s.cost < before - LK_EPS) {
+                accepted++;
+                lk_offer(&s, sol->route);
+                telemetry_point(telemetry, s.cost + total_time, -DBL_MAX);
+            } else {
+                lk_undo(&s);
+                s.cost = before;
+            }
+            if (s.stop != STOP_NONE) {
+                write_log("Perturbações encerradas: %s\n", stop_reason_text(s.stop));
+            }
+
+            if (elapsed >= next_report) {
+                write_log("Tempo: %.1f s, perturbações: %lld, melhor custo: %.2f\n",
+                          elapsed, kicks, s.cost + total_time);
+                next_report = elapsed + config.progress_interval;
+            }
+        }
+        write_log("\nPerturbações: %lld (%lld melhoraram a rota)\n", kicks, accepted);
+
+        // Rota começando em KingsLanding
+        int start = s.pos[0];
+        for (int p = 0; p < n; p++) {
+            sol->route[p] = s.tour[(start + p) % n];
+        }
+        sol->cost = calculate_cost(inst, sol->route);
+        sol->feasible = 1;
+
+        free(s.tour);
+        free(s.pos);
+        free(s.neigh);
+        free(s.queue);
+        free(s.in_queue);
+        free(s.journal);
+    }
+
+    if (sol->feasible) {
+        sol->total_time = total_time;
+        double lb = lk_lower_bound(inst);
+        sol->gap = ((sol->cost - lb) / sol->cost) * 100.0;
+        if (sol->gap < 0) sol->gap = 0.0;
+        write_log("Limite inferior (menores saídas): %.2f\n", lb);
+        telemetry_point(telemetry, DBL_MAX, lb);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sol->time = (now.tv_sec - start_time.tv_sec) + (now.tv_nsec - start_time.tv_nsec) / 1e9;
+    telemetry_finish(telemetry, sol);
+
+    write_log("\nResultados finais:\n");
+    write_log("Status: %s\n", sol->feasible ? "Solução viável (heurística)" : "Sem solução viável");
+    write_log("Custo: %.2f\n", sol->cost);
+    write_log("Tempo: %.2f s\n", sol->time);
+    write_log("Gap: %.2f%%\n", sol->gap);
+    write_log("Viável: %s\n", sol->feasible ? "Sim" : "Não");
+
+    if (sol->feasible) {
+        write_log("\nRota encontrada:\n");
+        for (int i = 0; i < n; i++) {
+            write_log("%s ", inst->houses[sol->route[i]].name);
+        }
+        write_log("\n");
+    }
+
+    close_log();
+    return sol;
+}
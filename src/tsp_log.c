@@ -0,0 +1,233 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+/**
+ * Log assíncrono
+ *
+ * As mensagens são formatadas na thread que chama write_log e copiadas para
+ * um anel de registros de tamanho fixo; uma thread de escrita esvazia o anel
+ * e grava cada registro no arquivo de destino. Quem registra não faz chamada
+ * de sistema nem toma lock: reserva posições no anel com um único
+ * atomic_fetch_add e publica cada registro pelo seu número de sequência.
+ * Mensagens maiores que um registro ocupam posições consecutivas, então não
+ * se misturam com as de outras threads. Só se o anel estiver cheio quem
+ * registra espera a thread de escrita liberar espaço.
+ *
+ * A thread de escrita descarrega (fflush) os arquivos apenas quando o anel
+ * fica vazio. close_log não fecha o arquivo diretamente: envia um registro
+ * de fechamento, processado depois das mensagens pendentes do arquivo.
+ * log_shutdown (registrada com atexit) esvazia o anel e encerra a thread.
+ */
+
+#define LOG_SLOTS 8192          // Registros no anel (potência de 2)
+#define LOG_SLOT_TEXT 236       // Texto por registro (cada registro ocupa 256 bytes)
+#define LOG_LINE 1024           // Mensagens até este tamanho são formatadas na pilha
+#define LOG_DIRTY_FILES 64      // Arquivos com dados ainda não descarregados
+#define LOG_IDLE_NS 2000000     // Espera da thread de escrita com o anel vazio (2 ms)
+
+// Tipos de registro
+enum { LOG_TEXT, LOG_CLOSE };
+
+typedef struct {
+    atomic_size_t seq;          // posição + 1 quando publicado; posição + LOG_SLOTS quando livre
+    FILE* file;
+    unsigned short len;
+    unsigned short kind;
+    char text[LOG_SLOT_TEXT];
+} LogSlot;
+
+// Arquivo de log da thread atual (uma variável por thread)
+_Thread_local FILE* log_file = NULL;
+
+static LogSlot ring[LOG_SLOTS];
+static atomic_size_t ring_head;         // Próxima posição a reservar
+static size_t ring_tail;                // Próxima posição a gravar (só a thread de escrita)
+static atomic_int writer_running;
+static atomic_int writer_stop;
+static pthread_t writer;
+static pthread_once_t writer_once = PTHREAD_ONCE_INIT;
+
+// Arquivos gravados desde o último fflush (só a thread de escrita)
+static FILE* dirty[LOG_DIRTY_FILES];
+static int num_dirty;
+
+// Marca um arquivo para ser descarregado quando o anel esvaziar
+static void mark_dirty(FILE* file) {
+    for (int i = 0; i < num_dirty; i++) {
+        if (dirty[i] == file) return;
+    }
+    if (num_dirty < LOG_DIRTY_FILES) {
+        dirty[num_dirty++] = file;
+    } else {
+        fflush(file);
+    }
+}
+
+static void flush_dirty(void) {
+    for (int i = 0; i < num_dirty; i++) {
+        fflush(dirty[i]);
+    }
+    num_dirty = 0;
+}
+
+// Fecha um arquivo, tirando-o da lista de pendentes
+static void close_file(FILE* file) {
+    for (int i = 0; i < num_dirty; i++) {
+        if (dirty[i] == file) {
+            dirty[i] = dirty[--num_dirty];
+            break;
+        }
+    }
+    fclose(file);
+}
+
+// Thread de escrita: grava os registros na ordem do anel
+static void* writer_run(void* arg) {
+    (void)arg;
+    struct timespec idle = { 0, LOG_IDLE_NS };
+    for (;;) {
+        LogSlot* slot = &ring[ring_tail & (LOG_SLOTS - 1)];
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) == ring_tail + 1) {
+            if (slot->kind == LOG_CLOSE) {
+                close_file(slot->file);
+            } else {
+                fwrite(slot->text, 1, slot->len, slot->file);
+                mark_dirty(slot->file);
+            }
+            atomic_store_explicit(&slot->seq, ring_tail + LOG_SLOTS, memory_order_release);
+            ring_tail++;
+            continue;
+        }
+
+        // Anel vazio (ou próximo registro ainda sendo preenchido)
+        flush_dirty();
+        if (atomic_load(&writer_stop) &&
+            atomic_load(&ring_head) == ring_tail) {
+            break;
+        }
+        nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+static void writer_start(void) {
+    for (size_t i = 0; i < LOG_SLOTS; i++) {
+        atomic_init(&ring[i].seq, i);
+    }
+    if (pthread_create(&writer, NULL, writer_run, NULL) == 0) {
+        atomic_store(&writer_running, 1);
+        atexit(log_shutdown);
+    }
+}
+
+// Esvazia o anel e encerra a thread de escrita (chamada na saída do programa)
+void log_shutdown(void) {
+    if (!atomic_exchange(&writer_running, 0)) {
+        return;
+    }
+    atomic_store(&writer_stop, 1);
+    pthread_join(writer, NULL);
+}
+
+// Coloca uma mensagem no anel, em registros consecutivos
+static void submit(FILE* file, const char* text, size_t len, int kind) {
+    if (!atomic_load_explicit(&writer_running, memory_order_relaxed)) {
+        // Sem a thread de escrita (falha na criação ou depois do encerramento)
+        if (kind == LOG_CLOSE) {
+            fclose(file);
+        } else {
+            fwrite(text, 1, len, file);
+        }
+        return;
+    }
+    size_t count = len == 0 ? 1 : (len + LOG_SLOT_TEXT - 1) / LOG_SLOT_TEXT;
+    size_t pos = atomic_fetch_add_explicit(&ring_head, count, memory_order_relaxed);
+    for (size_t k = 0; k < count; k++, pos++) {
+        LogSlot* slot = &ring[pos & (LOG_SLOTS - 1)];
+        // Anel cheio: espera a thread de escrita liberar a posição
+        while (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos) {
+            sched_yield();
+        }
+        size_t chunk = len > LOG_SLOT_TEXT ? LOG_SLOT_TEXT : len;
+        if (chunk > 0) {
+            memcpy(slot->text, text, chunk);
+        }
+        slot->len = (unsigned short)chunk;
+        slot->kind = (unsigned short)kind;
+        slot->file = file;
+        atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+        text += chunk;
+        len -= chunk;
+    }
+}
+
+// Formata a mensagem e a envia para o log da thread
+static void vlog(const char* format, va_list args) {
+    char line[LOG_LINE];
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(line, sizeof(line), format, copy);
+    va_end(copy);
+    if (len < 0) {
+        return;
+    }
+    if ((size_t)len < sizeof(line)) {
+        submit(log_file, line, (size_t)len, LOG_TEXT);
+        return;
+    }
+    // Mensagem longa (ex.: linha da matriz de custos)
+    char* buffer = (char*)malloc((size_t)len + 1);
+    if (!buffer) {
+        return;
+    }
+    vsnprintf(buffer, (size_t)len + 1, format, args);
+    submit(log_file, buffer, (size_t)len, LOG_TEXT);
+    free(buffer);
+}
+
+// Registra uma mensagem no nível LOG_INFO
+void write_log(const char* format, ...) {
+    if (!log_enabled(LOG_INFO)) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vlog(format, args);
+    va_end(args);
+}
+
+// Registra uma mensagem no nível indicado
+void write_log_at(LogLevel level, const char* format, ...) {
+    if (!log_enabled(level)) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vlog(format, args);
+    va_end(args);
+}
+
+// Função para abrir arquivo de log
+void open_log(const char* filename) {
+    pthread_once(&writer_once, writer_start);
+    log_file = fopen(filename, "w");
+    if (!log_file) {
+        printf("Erro ao abrir arquivo de log: %s\n", filename);
+        exit(1);
+    }
+}
+
+// Função para fechar arquivo de log: o arquivo é fechado pela thread de
+// escrita depois das mensagens pendentes
+void close_log() {
+    if (log_file) {
+        submit(log_file, NULL, 0, LOG_CLOSE);
+        log_file = NULL;
+    }
+}
@@ -3,9 +3,526 @@
 #include <stdlib.h>
 #include <string.h>
 #include <float.h>
+#include <limits.h>
+#include <math.h>
 #include <glpk.h>
 #include <time.h>
 
+// Coluna de x[i][j] (i != j, base 1 como no GLPK): os arcos que saem de i
+// ficam contíguos e não há colunas para x[i][i]
+static inline int mip_x_col(int n, int i, int j) {
+    return i * (n - 1) + (j < i ? j : j - 1) + 1;
+}
+
+// Coluna de u[i] (formulação MTZ, i >= 1), depois de todos os arcos
+static inline int mip_u_col(int n, int i) {
+    return n * (n - 1) + i;
+}
+
+// Dimensões do modelo montado
+typedef struct {
+    int cols;
+    int rows;
+    int nnz;
+} MipModelSize;
+
+// Monta variáveis, objetivo e restrições iniciais do modelo:
+// - x[i][j], i != j: binárias, custo = distância * (1 + risco) + tempo mínimo de j
+// - u[i], i >= 1 (só MTZ): inteiras em [0, n-1]
+// - grau de entrada e de saída de cada cidade (= 1) e, na MTZ,
+//   u[i] - u[j] + n*x[i][j] <= n-1 para i, j >= 1 distintos
+// Os não nulos são contados antes e ia/ja/ar têm exatamente esse tamanho.
+// Nomes de linhas e colunas só são gerados se names != 0
+static MipModelSize mip_build_model(glp_prob* prob, const Instance* inst, int mtz, int names) {
+    int n = inst->n;
+    MipModelSize size;
+    size.cols = n * (n - 1) + (mtz ? n - 1 : 0);
+    size.rows = 2 * n + (mtz ? (n - 1) * (n - 2) : 0);
+    size.nnz = 2 * n * (n - 1) + (mtz ? 3 * (n - 1) * (n - 2) : 0);
+    char name[40];
+
+    if (size.cols > 0) {
+        glp_add_cols(prob, size.cols);
+    }
+    glp_add_rows(prob, size.rows);
+
+    // Custos dos arcos com o tempo mínimo do destino já incluído
+    double* arc_cost = build_cost_matrix(inst, 1);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i == j) continue;
+            int col = mip_x_col(n, i, j);
+            glp_set_col_kind(prob, col, GLP_BV);
+            glp_set_obj_coef(prob, col, arc_cost[i * n + j]);
+            if (names) {
+                snprintf(name, sizeof(name), "x_%d_%d", i + 1, j + 1);
+                glp_set_col_name(prob, col, name);
+            }
+        }
+    }
+    free(arc_cost);
+
+    for (int i = 1; mtz && i < n; i++) {
+        int col = mip_u_col(n, i);
+        glp_set_col_kind(prob, col, GLP_IV);
+        glp_set_col_bnds(prob, col, GLP_DB, 0.0, n - 1);
+        if (names) {
+            snprintf(name, sizeof(name), "u_%d", i);
+            glp_set_col_name(prob, col, name);
+        }
+    }
+
+    int* ia = (int*)malloc((1 + size.nnz) * sizeof(int));
+    int* ja = (int*)malloc((1 + size.nnz) * sizeof(int));
+    double* ar = (double*)malloc((1 + size.nnz) * sizeof(double));
+    int pos = 1;
+
+    // Grau: linha j+1 é a entrada de j, linha n+i+1 é a saída de i
+    for (int i = 0; i < n; i++) {
+        glp_set_row_bnds(prob, i + 1, GLP_FX, 1.0, 1.0);
+        glp_set_row_bnds(prob, n + i + 1, GLP_FX, 1.0, 1.0);
+        if (names) {
+            snprintf(name, sizeof(name), "in_%d", i + 1);
+            glp_set_row_name(prob, i + 1, name);
+            snprintf(name, sizeof(name), "out_%d", i + 1);
+            glp_set_row_name(prob, n + i + 1, name);
+        }
+        for (int j = 0; j < n; j++) {
+            if (i == j) continue;
+            int col = mip_x_col(n, i, j);
+            ia[pos] = j + 1;      ja[pos] = col; ar[pos++] = 1.0;
+            ia[pos] = n + i + 1;  ja[pos] = col; ar[pos++] = 1.0;
+        }
+    }
+
+    // MTZ: u[i] - u[j] + n*x[i][j] <= n-1
+    int row = 2 * n + 1;
+    for (int i = 1; mtz && i < n; i++) {
+        for (int j = 1; j < n; j++) {
+            if (i == j) continue;
+            glp_set_row_bnds(prob, row, GLP_UP, 0.0, n - 1);
+            if (names) {
+                snprintf(name, sizeof(name), "mtz_%d_%d", i, j);
+                glp_set_row_name(prob, row, name);
+            }
+            ia[pos] = row; ja[pos] = mip_u_col(n, i);    ar[pos++] = 1.0;
+            ia[pos] = row; ja[pos] = mip_u_col(n, j);    ar[pos++] = -1.0;
+            ia[pos] = row; ja[pos] = mip_x_col(n, i, j); ar[pos++] = n;
+            row++;
+        }
+    }
+
+    glp_load_matrix(prob, pos - 1, ia, ja, ar);
+    free(ia);
+    free(ja);
+    free(ar);
+    return size;
+}
+
+// Fixa em zero os arcos x[i][j] não básicos no limite inferior cujo custo
+// reduzido d leva a relaxação acima da incumbente: toda solução com
+// x[i][j] = 1 custa pelo menos lb + d > ub. Exige a relaxação resolvida.
+// Retorna o número de arcos fixados
+static int mip_fix_arcs(glp_prob* prob, int n, double lb, double ub) {
+    int fixed = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i == j) continue;
+            int col = mip_x_col(n, i, j);
+            if (glp_get_col_stat(prob, col) != GLP_NL) continue;
+            if (lb + glp_get_col_dual(prob, col) > ub + 1e-6) {
+                glp_set_col_bnds(prob, col, GLP_FX, 0.0, 0.0);
+                fixed++;
+            }
+        }
+    }
+    return fixed;
+}
+
+// Tolerâncias da separação de cortes de subciclo
+#define MIP_SUPPORT_EPS 1e-6    // Arcos com x abaixo disto ficam fora do grafo suporte
+#define MIP_CUT_TOL 1e-4        // Violação mínima para adicionar um corte
+
+// Dados da callback do GLPK
+typedef struct {
+    int n;
+    const Instance* inst;
+    MipFormulation formulation;
+    const int* route;   // Rota inicial (NULL se não há)
+    int* next;          // Sucessor de cada cidade na rota inicial
+    int sent;           // Rota já entregue ao GLPK
+    int branches;       // Ramificações em arcos da rota inicial
+    // Separação dos cortes de subciclo (formulação DFJ)
+    double* x;          // Valores de x[i][j] na relaxação do subproblema atual
+    double* w;          // Capacidades x[i][j] + x[j][i] do grafo suporte (contraído)
+    double* key;        // Conectividade com os vértices já ordenados (Stoer-Wagner)
+    int* owner;         // Vértice contraído que contém cada cidade
+    int* active;        // Vértices ainda não contraídos
+    int* added;         // Vértice já ordenado na fase atual
+    int* in_set;        // Cidades do conjunto S do corte
+    int* ind;           // Linha do corte (índices de coluna)
+    double* val;        // Linha do corte (coeficientes)
+    int cuts;           // Cortes adicionados
+    int root_rounds;    // Rodadas de cortes na raiz
+    int root_done;      // Relaxação da raiz sem cortes violados
+    double root_bound;  // Valor da relaxação da raiz com os cortes
+    // Portfólio de métodos
+    int* shared_route;  // Última rota recebida do portfólio (NULL fora dele)
+    double shared_cost; // Custo da melhor rota já entregue ao GLPK
+    // Telemetria
+    Telemetry* telemetry;
+    long long nodes;        // Nós gerados na árvore
+    long long peak_active;  // Pico de nós ativos
+    double next_point;      // Tempo do próximo ponto do limite na telemetria
+    // Limites da execução
+    double best_bound;      // Limite do melhor nó ativo (limite inferior global)
+    double next_memory;     // Tempo da próxima verificação do limite de memória
+    StopReason stop;        // Motivo da parada pedida pela callback
+} MipCallbackData;
+
+// Intervalo (s) entre duas verificações do limite de memória na callback
+#define MIP_MEMORY_INTERVAL 0.5
+
+// Fluxo que sai do conjunto S: Σ x[i][j] com i ∈ S e j ∉ S
+static double mip_set_outflow(const MipCallbackData* data) {
+    int n = data->n;
+    double flow = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (!data->in_set[i]) continue;
+        for (int j = 0; j < n; j++) {
+            if (!data->in_set[j]) {
+                flow += data->x[i * n + j];
+            }
+        }
+    }
+    return flow;
+}
+
+// Adiciona o corte de subciclo do conjunto S (in_set). Com os graus fixos,
+// Σ x[i][j] (i ∈ S, j ∉ S) >= 1 equivale a Σ x[i][j] (i, j ∈ S) <= |S| - 1;
+// usa a forma com menos coeficientes
+static void mip_add_subtour_cut(glp_prob* prob, MipCallbackData* data, int size) {
+    int n = data->n;
+    int inner = size - 1 <= n - size;
+    int len = 0;
+    for (int i = 0; i < n; i++) {
+        if (!data->in_set[i]) continue;
+        for (int j = 0; j < n; j++) {
+            if (j != i && data->in_set[j] == inner) {
+                len++;
+                data->ind[len] = mip_x_col(n, i, j);
+                data->val[len] = 1.0;
+            }
+        }
+    }
+    int row = glp_add_rows(prob, 1);
+    if (config.mip_names) {
+        glp_set_row_name(prob, row, "sec");
+    }
+    if (inner) {
+        glp_set_row_bnds(prob, row, GLP_UP, 0.0, size - 1);
+    } else {
+        glp_set_row_bnds(prob, row, GLP_LO, 1.0, 0.0);
+    }
+    glp_set_mat_row(prob, row, len, data->ind, data->val);
+    data->cuts++;
+}
+
+// Separa cortes de subciclo violados pela relaxação do subproblema atual.
+// Se o grafo suporte é desconexo, cada componente gera um corte; senão o
+// corte mínimo global (Stoer-Wagner) e os cortes de cada fase com
+// capacidade menor que 2 (fluxo de saída menor que 1) são adicionados.
+// Retorna o número de cortes adicionados
+static int mip_separate_subtours(glp_prob* prob, MipCallbackData* data) {
+    int n = data->n;
+    double* x = data->x;
+    double* w = data->w;
+    for (int i = 0; i < n; i++) {
+        x[i * n + i] = 0.0;
+        for (int j = 0; j < n; j++) {
+            if (j != i) {
+                double value = glp_get_col_prim(prob, mip_x_col(n, i, j));
+                x[i * n + j] = value > MIP_SUPPORT_EPS ? value : 0.0;
+            }
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            w[i * n + j] = x[i * n + j] + x[j * n + i];
+        }
+    }
+
+    // Componentes conexas do grafo suporte (busca em profundidade)
+    int* comp = data->owner;
+    int* stack = data->active;
+    int num_comp = 0;
+    for (int i = 0; i < n; i++) {
+        comp[i] = -1;
+    }
+    for (int s = 0; s < n; s++) {
+        if (comp[s] >= 0) continue;
+        int top = 0;
+        stack[top++] = s;
+        comp[s] = num_comp;
+        while (top > 0) {
+            int v = stack[--top];
+            for (int u = 0; u < n; u++) {
+                if (comp[u] < 0 && w[v * n + u] > 0.0) {
+                    comp[u] = num_comp;
+                    stack[top++] = u;
+                }
+            }
+        }
+        num_comp++;
+    }
+    if (num_comp > 1) {
+        for (int c = 0; c < num_comp; c++) {
+            int size = 0;
+            for (int i = 0; i < n; i++) {
+                data->in_set[i] = comp[i] == c;
+                size += data->in_set[i];
+            }
+            mip_add_subtour_cut(prob, data, size);
+        }
+        return num_comp;
+    }
+
+    // Grafo conexo: cortes mínimos pelas fases de Stoer-Wagner
+    int added_cuts = 0;
+    int m = n;
+    for (int i = 0; i < n; i++) {
+        data->owner[i] = i;
+        data->active[i] = i;
+    }
+    while (m > 1 && added_cuts < n) {
+        for (int t = 0; t < m; t++) {
+            data->added[data->active[t]] = 0;
+            data->key[data->active[t]] = 0.0;
+        }
+        int prev = -1, last = -1;
+        double cut = 0.0;
+        for (int it = 0; it < m; it++) {
+            // Vértice mais conectado aos já ordenados
+            int v = -1;
+            for (int t = 0; t < m; t++) {
+                int u = data->active[t];
+                if (!data->added[u] && (v < 0 || data->key[u] > data->key[v])) {
+                    v = u;
+                }
+            }
+            data->added[v] = 1;
+            prev = last;
+            last = v;
+            cut = data->key[v];
+            for (int t = 0; t < m; t++) {
+                int u = data->active[t];
+                if (!data->added[u]) {
+                    data->key[u] += w[v * n + u];
+                }
+            }
+        }
+
+        // Corte da fase: cidades contraídas em last contra o resto
+        if (cut < 2.0 - 2.0 * MIP_CUT_TOL) {
+            int size = 0;
+            for (int i = 0; i < n; i++) {
+                data->in_set[i] = data->owner[i] == last;
+                size += data->in_set[i];
+            }
+            if (mip_set_outflow(data) < 1.0 - MIP_CUT_TOL) {
+                mip_add_subtour_cut(prob, data, size);
+                added_cuts++;
+            }
+        }
+
+        // Contrai last em prev
+        for (int t = 0; t < m; t++) {
+            int u = data->active[t];
+            w[prev * n + u] += w[last * n + u];
+            w[u * n + prev] = w[prev * n + u];
+        }
+        w[prev * n + prev] = 0.0;
+        for (int i = 0; i < n; i++) {
+            if (data->owner[i] == last) {
+                data->owner[i] = prev;
+            }
+        }
+        for (int t = 0; t < m; t++) {
+            if (data->active[t] == last) {
+                data->active[t] = data->active[--m];
+                break;
+            }
+        }
+    }
+    return added_cuts;
+}
+
+// Entrega uma rota como solução inteira (x[i][j] dos arcos da rota e, na
+// formulação MTZ, u[i] = posição de i na rota)
+static void mip_send_heuristic(glp_tree* tree, MipCallbackData* data, const int* route) {
+    int n = data->n;
+    glp_prob* prob = glp_ios_get_prob(tree);
+    double* x = (double*)calloc(glp_get_num_cols(prob) + 1, sizeof(double));
+    for (int pos = 0; pos < n; pos++) {
+        int i = route[pos];
+        int j = route[(pos + 1) % n];
+        x[mip_x_col(n, i, j)] = 1.0;
+        if (i != 0 && data->formulation == MIP_MTZ) {
+            x[mip_u_col(n, i)] = pos;
+        }
+    }
+    glp_ios_heur_sol(tree, x);
+    free(x);
+}
+
+// Segue os arcos com x = 1 a partir da cidade 0, usando col_value(prob, col)
+// para ler os valores. Retorna 1 se eles formam uma rota com todas as cidades
+static int mip_extract_route(glp_prob* prob, int n, double (*col_value)(glp_prob*, int),
+                             int* route) {
+    int current = 0;
+    for (int pos = 0; pos < n; pos++) {
+        route[pos] = current;
+        int next = -1;
+        for (int j = 0; j < n; j++) {
+            if (j != current && col_value(prob, mip_x_col(n, current, j)) > 0.5) {
+                next = j;
+                break;
+            }
+        }
+        if (next < 0 || (next == 0) != (pos == n - 1)) {
+            return 0;
+        }
+        current = next;
+    }
+    return 1;
+}
+
+// Publica no portfólio a solução inteira encontrada pelo GLPK
+static void mip_offer(glp_tree* tree, MipCallbackData* data) {
+    glp_prob* prob = glp_ios_get_prob(tree);
+    if (mip_extract_route(prob, data->n, glp_get_col_prim, data->shared_route)) {
+        double cost = calculate_cost(data->inst, data->shared_route);
+        portfolio_offer(data->shared_route, cost);
+        if (cost < data->shared_cost) {
+            data->shared_cost = cost;
+        }
+    }
+}
+
+// Ramifica no arco fracionário da rota inicial com valor mais próximo de
+// 0,5, explorando primeiro o ramo x = 1 (a busca segue a estrutura da
+// incumbente). Sem candidatos, a escolha fica com o GLPK
+static void mip_branch(glp_tree* tree, MipCallbackData* data) {
+    int n = data->n;
+    glp_prob* prob = glp_ios_get_prob(tree);
+    int best = 0;
+    double best_dist = 1.0;
+    for (int i = 0; i < n; i++) {
+        int col = mip_x_col(n, i, data->next[i]);
+        if (!glp_ios_can_branch(tree, col)) continue;
+        double dist = fabs(glp_get_col_prim(prob, col) - 0.5);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = col;
+        }
+    }
+    if (best) {
+        glp_ios_branch_upon(tree, best, GLP_UP_BRNCH);
+        data->branches++;
+    }
+}
+
+// Callback do branch-and-cut:
+// - GLP_IROWGEN: na formulação DFJ, adiciona os cortes de subciclo violados
+//   pela relaxação (inclusive por soluções inteiras com subciclos)
+// - GLP_IHEUR: na primeira chamada entrega a rota inicial
+// - GLP_IBRANCH: prefere ramificar nos arcos da rota inicial
+// - GLP_IBINGO e GLP_ISELECT: registram na telemetria as soluções inteiras,
+//   o limite do melhor nó ativo e o tamanho da árvore
+// No portfólio também entrega ao GLPK as rotas melhores dos outros métodos
+// (GLP_IHEUR), publica as soluções inteiras (GLP_IBINGO) e o limite do
+// melhor nó ativo (GLP_ISELECT). Encerra a busca quando o portfólio para,
+// com SIGINT/SIGTERM e nos limites de nós e de memória
+static void mip_callback(glp_tree* tree, void* info) {
+    MipCallbackData* data = (MipCallbackData*)info;
+    double now = telemetry_elapsed(data->telemetry);
+    StopReason reason = limit_reached(now, data->nodes);
+    if (reason == STOP_NONE && now >= data->next_memory) {
+        data->next_memory = now + MIP_MEMORY_INTERVAL;
+        if (memory_limit_reached()) {
+            reason = STOP_MEMORY;
+        }
+    }
+    if (reason != STOP_NONE) {
+        data->stop = reason;
+        glp_ios_terminate(tree);
+        return;
+    }
+    switch (glp_ios_reason(tree)) {
+        case GLP_IROWGEN:
+            if (data->formulation == MIP_DFJ) {
+                glp_prob* prob = glp_ios_get_prob(tree);
+                int root = glp_ios_up_node(tree, glp_ios_curr_node(tree)) == 0;
+                int added = mip_separate_subtours(prob, data);
+                if (root && !data->root_done) {
+                    if (added > 0) {
+                        data->root_rounds++;
+                    } else {
+                        data->root_done = 1;
+                        data->root_bound = glp_get_obj_val(prob);
+                        portfolio_bound(data->root_bound);
+                    }
+                }
+            }
+            break;
+        case GLP_IHEUR:
+            if (!data->sent && data->route) {
+                mip_send_heuristic(tree, data, data->route);
+                data->sent = 1;
+            }
+            if (data->shared_route &&
+                portfolio_fetch(data->shared_route, &data->shared_cost)) {
+                mip_send_heuristic(tree, data, data->shared_route);
+            }
+            break;
+        case GLP_IBINGO:
+            telemetry_point(data->telemetry, glp_get_obj_val(glp_ios_get_prob(tree)), -DBL_MAX);
+            if (data->shared_route) {
+                mip_offer(tree, data);
+            }
+            break;
+        case GLP_ISELECT: {
+            int best = glp_ios_best_node(tree);
+            double bound = best ? glp_ios_node_bound(tree, best) : -DBL_MAX;
+            if (bound > data->best_bound) {
+                data->best_bound = bound;
+            }
+            if (data->shared_route && best) {
+                portfolio_bound(bound);
+            }
+            int active, current, total;
+            glp_ios_tree_size(tree, &active, &current, &total);
+            data->nodes = total;
+            if (active > data->peak_active) {
+                data->peak_active = active;
+            }
+            // Limite do melhor nó na telemetria, no intervalo do progresso
+            if (now >= data->next_point) {
+                telemetry_point(data->telemetry, DBL_MAX, bound);
+                data->next_point = now + config.progress_interval;
+            }
+            break;
+        }
+        case GLP_IBRANCH:
+            if (data->route) {
+                mip_branch(tree, data);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
 /**
  * Resolve o Problema do Caixeiro Viajante usando Programação Linear Inteira
  * 
@@ -21,47 +538,44 @@
  * 1. Fluxo de entrada:  Σ(i) x[i][j] = 1 para todo j
  * 2. Fluxo de saída:    Σ(j) x[i][j] = 1 para todo i
  * 3. MTZ (subciclos):   u[i] - u[j] + n*x[i][j] <= n-1 para todo i,j != 1
+ *
+ * Com --formulation dfj as variáveis u e as restrições MTZ saem do modelo,
+ * que começa só com as restrições de grau. Os cortes de subciclo de
+ * Dantzig-Fulkerson-Johnson, Σ x[i][j] (i ∈ S, j ∉ S) >= 1, são separados
+ * na callback (GLP_IROWGEN) sobre a relaxação de cada subproblema, por
+ * componentes conexas ou corte mínimo do grafo suporte
  */
-Solution* solve_mip(const Instance* inst, const char* nome_arquivo) {
+Solution* solve_mip(const Instance* inst, const char* nome_arquivo, const int* initial_route) {
+    // Tempo de relógio desde o início: clock() somaria o tempo de CPU de
+    // todas as threads (lote, portfólio) e não cobriria heurística e modelo
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
     // Extrai nome base do arquivo (remove path e extensão)
-    const char* nome_base = strrchr(nome_arquivo, '/');
-    if (nome_base) {
-        nome_base++; // Pula a barra
-    } else {
-        nome_base = nome_arquivo;
-    }
     char nome_instancia[256];
-    strncpy(nome_instancia, nome_base, sizeof(nome_instancia)-1);
-    char* ext = strstr(nome_instancia, ".txt");
-    if (ext) *ext = '\0';  // Remove extensão .txt
+    instance_base_name(nome_arquivo, nome_instancia, sizeof(nome_instancia));
     
     // Inicializa arquivo de log
-    char log_filename[256];
-    sprintf(log_filename, "logs/%s_PLI.log", nome_instancia);
-    FILE* log_file = fopen(log_filename, "w");
+    char log_filename[300];
+    snprintf(log_filename, sizeof(log_filename), "logs/%s_PLI.log", nome_instancia);
+    open_log(log_filename);
 
     // Cabeçalho do log
-    fprintf(log_file, "=== PLI para TSP ===\n");
-    fprintf(log_file, "Instância: %s\n", nome_instancia);
-    fprintf(log_file, "Método: PLI\n");
-    fprintf(log_file, "Número de cidades: %d\n\n", inst->n);
+    write_log("=== PLI para TSP ===\n");
+    write_log("Instância: %s\n", nome_instancia);
+    write_log("Método: PLI\n");
+    write_log("Número de cidades: %d\n\n", inst->n);
     
-    // Imprime matriz de custos
-    fprintf(log_file, "Matriz de custos (distância * (1 + risco)):\n");
-    for (int i = 0; i < inst->n; i++) {
-        for (int j = 0; j < inst->n; j++) {
-            fprintf(log_file, "%7.2f ", inst->dist[i][j] * (1.0 + inst->risk[i][j]));
-        }
-        fprintf(log_file, "\n");
-    }
+    // Matriz de custos (só no nível debug)
+    log_cost_matrix(inst);
     
     // Imprime tempos mínimos
-    fprintf(log_file, "\nTempos mínimos:\n");
+    write_log("Tempos mínimos:\n");
     for (int i = 0; i < inst->n; i++) {
-        fprintf(log_file, "%s: %d\n", inst->houses[i].name, inst->houses[i].min_time);
+        write_log("%s: %d\n", inst->houses[i].name, inst->houses[i].min_time);
     }
     
-    fprintf(log_file, "\n=== Execução do algoritmo ===\n");
+    write_log("\n=== Execução do algoritmo ===\n");
     
     // Inicializa estrutura de solução
     Solution* solucao = (Solution*)malloc(sizeof(Solution));
@@ -69,163 +583,102 @@ Solution* solve_mip(const Instance* inst, const char* nome_arquivo) {
     solucao->cost = 0.0;
     solucao->feasible = 0;
     solucao->gap = 0.0;
+    solucao->optimal = 0;
+    solucao->engine = ENGINE_MIP;
+    Telemetry* telemetry = telemetry_create(nome_instancia, ENGINE_MIP);
     
     int n = inst->n;
-    write_log("Número de cidades: %d\n", n);
-    
-    // Cria problema GLPK
-    glp_prob* prob = glp_create_prob();
-    glp_set_prob_name(prob, "tsp");
-    glp_set_obj_dir(prob, GLP_MIN);  // Problema de minimização
     
-    // Define variáveis do problema:
-    // - x[i][j]: variáveis binárias para arcos
-    // - u[i]: variáveis inteiras para MTZ (ordem das cidades)
-    int num_vars = n * n + n;  // x[i][j] + u[i]
-    glp_add_cols(prob, num_vars);
-    
-    // Define variáveis x[i][j] e seus custos
+    // Rota inicial: a melhor entre a fornecida (de outra execução, do BB,
+    // ...) e a heurística. Vira a primeira incumbente do GLPK, limita os
+    // arcos pelo custo reduzido e é a resposta caso ele não encontre
+    // solução no tempo limite
+    int total_time = 0;
     for (int i = 0; i < n; i++) {
-        // Define variáveis x[i][j]
-        for (int j = 0; j < n; j++) {
-            int idx = i * n + j + 1;
-            char name[20];
-            sprintf(name, "x_%d_%d", i+1, j+1);
-            // Define o nome da variável
-            glp_set_col_name(prob, idx, name);
-            // Define o tipo da variável como binária
-            glp_set_col_kind(prob, idx, GLP_BV);  
-            
-            if (i != j) {  // Não permite arcos para mesma cidade
-                // Custo = distância * (1 + risco) + tempo mínimo
-                double custo = inst->dist[i][j] * (1.0 + inst->risk[i][j]) + 
-                             inst->houses[j].min_time;
-                // Define o coeficiente da função objetivo para a variável x[i][j]
-                glp_set_obj_coef(prob, idx, custo);
-            }
-        }
+        total_time += inst->houses[i].min_time;
     }
-    
-    // Define variáveis u[i] para MTZ (eliminação de subciclos)
-    for (int i = 1; i < n; i++) {
-        int idx = n * n + i;
-        char name[20];
-        sprintf(name, "u_%d", i);
-        glp_set_col_name(prob, idx, name);
-        glp_set_col_kind(prob, idx, GLP_IV);  // Variável inteira
-        glp_set_col_bnds(prob, idx, GLP_DB, 0.0, n-1);  // 0 <= u[i] <= n-1
+    int* heur_route = NULL;
+    double heur_cost = 0.0;
+    telemetry_phase(telemetry, "heuristic");
+    if (initial_route && total_time <= inst->houses[0].power) {
+        heur_route = (int*)malloc(n * sizeof(int));
+        memcpy(heur_route, initial_route, n * sizeof(int));
+        heur_cost = calculate_cost(inst, heur_route);
+        write_log("Rota inicial fornecida: %.2f\n", heur_cost);
     }
-    
-    // Define restrições:
-    // - Fluxo de entrada/saída
-    // - MTZ para eliminação de subciclos
-    // - A primeira cidade (origem) tem ordem 0
-    // - As demais cidades têm ordem entre 1 e n-1
-    // - Se existe um arco de i para j (x[i][j] = 1), então u[j] > u[i]
-
-    int num_rows = 2 * n + (n-1)*(n-1);  // Entrada + Saída + MTZ
-    glp_add_rows(prob, num_rows);
-    
-    // Aloca memória para matriz esparsa
-    int max_elem = num_vars * num_rows;
-    int* ia = (int*)malloc((1 + max_elem) * sizeof(int));
-    int* ja = (int*)malloc((1 + max_elem) * sizeof(int));
-    double* ar = (double*)malloc((1 + max_elem) * sizeof(double));
-    int pos = 1;
-    
-    // Restrições de entrada: Σ x[i][j] = 1 para todo j
-    for (int j = 0; j < n; j++) {
-        glp_set_row_name(prob, j+1, "in");
-        glp_set_row_bnds(prob, j+1, GLP_FX, 1.0, 1.0);  // Exatamente uma entrada
-        
-        // Define os coeficientes das restrições de entrada
-        for (int i = 0; i < n; i++) {
-            // Verifica se a cidade i é diferente da cidade j
-            if (i != j) {
-                // Define o índice da restrição, a coluna da variável e o coeficiente
-                ia[pos] = j+1;
-                ja[pos] = i * n + j + 1;
-                ar[pos] = 1.0;
-                pos++;
+    if (config.heuristic) {
+        int* route = (int*)malloc(n * sizeof(int));
+        double cost;
+        if (heuristic_tour(inst, route, &cost)) {
+            write_log("Solução heurística inicial (2-opt/Or-opt): %.2f\n", cost);
+            if (!heur_route || cost < heur_cost) {
+                free(heur_route);
+                heur_route = route;
+                heur_cost = cost;
+                route = NULL;
             }
         }
+        free(route);
     }
-    
-    // Restrições de saída: Σ x[i][j] = 1 para todo i
-    for (int i = 0; i < n; i++) {
-        glp_set_row_name(prob, n+i+1, "out");
-        glp_set_row_bnds(prob, n+i+1, GLP_FX, 1.0, 1.0);  // Exatamente uma saída
-        
-        // Define os coeficientes das restrições de saída
-        for (int j = 0; j < n; j++) {
-            if (i != j) {
-                // Define o índice da restrição, a coluna da variável e o coeficiente
-                ia[pos] = n+i+1;
-                ja[pos] = i * n + j + 1;    
-                ar[pos] = 1.0;
-                pos++;
-            }
-        }
+    if (heur_route) {
+        portfolio_offer(heur_route, heur_cost);
+        telemetry_point(telemetry, heur_cost, -DBL_MAX);
     }
     
-    // Restrições MTZ: u[i] - u[j] + n*x[i][j] <= n-1
-    // Elimina subciclos usando ordem das cidades
-    int row = 2*n + 1;
-    for (int i = 1; i < n; i++) {
-        for (int j = 1; j < n; j++) {
-            // Verifica se as cidades i e j são diferentes
-            if (i != j) {
-                char name[30];
-                sprintf(name, "mtz_%d_%d", i, j);
-                // Define o nome da restrição
-                glp_set_row_name(prob, row, name);
-                // Define o tipo da restrição como GLP_UP (superior)
-                glp_set_row_bnds(prob, row, GLP_UP, -DBL_MAX, n-1);
-                
-                // u[i] - u[j] + n*x[i][j] <= n-1
-                ia[pos] = row;
-                ja[pos] = n*n + i;
-                ar[pos++] = 1.0;  // u[i]
-                
-                ia[pos] = row;
-                ja[pos] = n*n + j;
-                ar[pos++] = -1.0;  // -u[j]
-                
-                ia[pos] = row;
-                ja[pos] = i*n + j + 1;
-                ar[pos++] = n;  // n*x[i][j]
-                
-                row++;
-            }
-        }
-    }
+    // Cria problema GLPK
+    telemetry_phase(telemetry, "model");
+    glp_prob* prob = glp_create_prob();
+    glp_set_prob_name(prob, "tsp");
+    glp_set_obj_dir(prob, GLP_MIN);  // Problema de minimização
     
-    // Carrega matriz de restrições
-    glp_load_matrix(prob, pos-1, ia, ja, ar);
+    // Monta o modelo com a matriz de restrições no tamanho exato
+    int mtz = config.formulation == MIP_MTZ;
+    MipModelSize model = mip_build_model(prob, inst, mtz, config.mip_names);
     
     // Resolve relaxação linear para bound inferior
     glp_smcp parm_lp;
     glp_init_smcp(&parm_lp);
     parm_lp.msg_lev = GLP_MSG_OFF;
     
-    fprintf(log_file, "Resolvendo relaxação linear...\n");
+    write_log("Resolvendo relaxação linear...\n");
+    telemetry_phase(telemetry, "lp_relaxation");
     int err_lp = glp_simplex(prob, &parm_lp);
     double lb = 0.0;
     if (err_lp == 0) {
         lb = glp_get_obj_val(prob);
-        fprintf(log_file, "Relaxação linear resolvida. Valor: %.2f\n", lb);
+        write_log("Relaxação linear resolvida. Valor: %.2f\n", lb);
     } else {
-        fprintf(log_file, "Erro na relaxação linear: %d\n", err_lp);
+        write_log_at(LOG_ERROR, "Erro na relaxação linear: %d\n", err_lp);
         lb = 0.0;
     }
+    int lp_optimal = err_lp == 0 && glp_get_status(prob) == GLP_OPT;
+    if (lp_optimal) {
+        portfolio_bound(lb);
+        telemetry_point(telemetry, DBL_MAX, lb);
+    }
+
+    // Arcos cujo custo reduzido leva a relaxação acima da rota inicial não
+    // aparecem em nenhuma solução melhor: ficam fixos em zero
+    if (lp_optimal && heur_route) {
+        int fixed = mip_fix_arcs(prob, n, lb, heur_cost);
+        write_log("Arcos fixados em zero pelo custo reduzido: %d de %d\n",
+                  fixed, n * (n - 1));
+        if (fixed > 0) {
+            err_lp = glp_simplex(prob, &parm_lp);
+            lp_optimal = err_lp == 0 && glp_get_status(prob) == GLP_OPT;
+        }
+    }
 
     // Configura parâmetros do GLPK para o MIP
     glp_iocp parm;
     glp_init_iocp(&parm);
     parm.presolve = GLP_ON;       // Ativa pré-processamento
     parm.msg_lev = GLP_MSG_OFF;   // Desativa mensagens
-    parm.tm_lim = 600000;         // 600 segundos (600000ms)
-    parm.mip_gap = 0.01;          // Gap de 1%
+    // Tempo restante do limite (o tempo até aqui já conta) e gap alvo (padrão 1%)
+    double remaining = config.time_limit - telemetry_elapsed(telemetry);
+    parm.tm_lim = remaining >= INT_MAX / 1000.0 ? INT_MAX :
+                  remaining > 0.001 ? (int)(remaining * 1000.0) : 1;
+    parm.mip_gap = target_gap(1.0) / 100.0;
     parm.br_tech = GLP_BR_PCH;    // Branching pseudocost
     parm.bt_tech = GLP_BT_BLB;    // Best local bound
     parm.pp_tech = GLP_PP_ALL;    // Preprocessamento completo
@@ -234,109 +687,234 @@ Solution* solve_mip(const Instance* inst, const char* nome_arquivo) {
     parm.mir_cuts = GLP_ON;       // Mixed integer rounding
     parm.cov_cuts = GLP_ON;       // Cover cuts
     parm.clq_cuts = GLP_ON;       // Clique cuts
+    
+    // A solução inicial e os cortes só podem ser entregues sem o presolver
+    // do MIP (a callback veria o problema transformado); a base ótima da
+    // relaxação já calculada acima permite desligá-lo
+    MipCallbackData cb_data;
+    memset(&cb_data, 0, sizeof(cb_data));
+    cb_data.n = n;
+    cb_data.inst = inst;
+    cb_data.formulation = config.formulation;
+    cb_data.shared_cost = heur_route ? heur_cost : DBL_MAX;
+    cb_data.telemetry = telemetry;
+    cb_data.nodes = -1;
+    cb_data.peak_active = -1;
+    cb_data.best_bound = -DBL_MAX;
+    cb_data.stop = STOP_NONE;
+    if (lp_optimal && (heur_route || !mtz || portfolio_current())) {
+        if (portfolio_current()) {
+            cb_data.shared_route = (int*)malloc(n * sizeof(int));
+        }
+        cb_data.route = heur_route;
+        if (heur_route) {
+            cb_data.next = (int*)malloc(n * sizeof(int));
+            for (int pos = 0; pos < n; pos++) {
+                cb_data.next[heur_route[pos]] = heur_route[(pos + 1) % n];
+            }
+        }
+        parm.presolve = GLP_OFF;
+    }
+    // A callback também aplica os limites da execução: é instalada mesmo
+    // com o presolver (ela então só consulta o tamanho e o limite da árvore)
+    parm.cb_func = mip_callback;
+    parm.cb_info = &cb_data;
+    if (!mtz) {
+        cb_data.x = (double*)malloc(n * n * sizeof(double));
+        cb_data.w = (double*)malloc(n * n * sizeof(double));
+        cb_data.key = (double*)malloc(n * sizeof(double));
+        cb_data.owner = (int*)malloc(n * sizeof(int));
+        cb_data.active = (int*)malloc(n * sizeof(int));
+        cb_data.added = (int*)malloc(n * sizeof(int));
+        cb_data.in_set = (int*)malloc(n * sizeof(int));
+        cb_data.ind = (int*)malloc((n * n + 1) * sizeof(int));
+        cb_data.val = (double*)malloc((n * n + 1) * sizeof(double));
+    }
 
-    fprintf(log_file, "\nResolvendo com parâmetros:\n");
-    fprintf(log_file, "- Tempo limite: %d segundos\n", parm.tm_lim/1000);
-    fprintf(log_file, "- Gap alvo: %.2f%%\n", parm.mip_gap*100);
-    fprintf(log_file, "- Presolve: %s\n", parm.presolve ? "ON" : "OFF");
-    fprintf(log_file, "- Cuts: GMI=%s MIR=%s COV=%s CLQ=%s\n",
-           parm.gmi_cuts ? "ON" : "OFF",
-           parm.mir_cuts ? "ON" : "OFF",
-           parm.cov_cuts ? "ON" : "OFF",
-           parm.clq_cuts ? "ON" : "OFF");
+    write_log("\nResolvendo com parâmetros:\n");
+    write_log("- Formulação: %s\n", mtz ? "MTZ" : "DFJ (cortes de subciclo sob demanda)");
+    write_log("- Modelo: %d variáveis, %d restrições, %d não nulos\n",
+              model.cols, model.rows, model.nnz);
+    write_log("- Tempo limite: %.0f segundos\n", config.time_limit);
+    if (config.node_limit > 0) {
+        write_log("- Limite de nós: %lld\n", config.node_limit);
+    }
+    if (config.mem_limit_mb > 0) {
+        write_log("- Limite de memória: %d MB\n", config.mem_limit_mb);
+    }
+    write_log("- Gap alvo: %.2f%%\n", parm.mip_gap*100);
+    write_log("- Presolve: %s\n", parm.presolve ? "ON" : "OFF");
+    write_log("- Cuts: GMI=%s MIR=%s COV=%s CLQ=%s\n",
+              parm.gmi_cuts ? "ON" : "OFF",
+              parm.mir_cuts ? "ON" : "OFF",
+              parm.cov_cuts ? "ON" : "OFF",
+              parm.clq_cuts ? "ON" : "OFF");
 
     // Resolve o MIP
-    clock_t start_time = clock();
-    fprintf(log_file, "\nIniciando resolução MIP...\n");
-    int err = glp_intopt(prob, &parm);
-    
-    // Atualiza tempo total gasto
-    solucao->time = (clock() - start_time) / (double)CLOCKS_PER_SEC;
+    write_log("\nIniciando resolução MIP...\n");
+    telemetry_phase(telemetry, "branch_and_cut");
+    int err;
+    if (!mtz && !lp_optimal) {
+        // Sem a base ótima o presolver não pode ser desligado, e sem a
+        // callback nenhum subciclo seria eliminado
+        write_log_at(LOG_ERROR, "Formulação DFJ exige a relaxação linear resolvida\n");
+        err = GLP_EFAIL;
+    } else {
+        err = glp_intopt(prob, &parm);
+    }
+    if (cb_data.route) {
+        write_log("Ramificações em arcos da rota inicial: %d\n", cb_data.branches);
+    }
+    if (!mtz) {
+        write_log("Cortes de subciclo adicionados: %d\n", cb_data.cuts);
+        if (cb_data.root_done) {
+            write_log("Relaxação da raiz com cortes: %.2f (%d rodadas)\n",
+                      cb_data.root_bound, cb_data.root_rounds);
+            // Limite bem mais forte que o da relaxação só com os graus
+            if (cb_data.root_bound > lb) {
+                lb = cb_data.root_bound;
+                telemetry_point(telemetry, DBL_MAX, lb);
+            }
+        }
+    }
     
+    // Limite inferior global: o melhor nó ativo na última seleção do GLPK
+    if (cb_data.best_bound > lb) {
+        lb = cb_data.best_bound;
+    }
+
+    // Motivo da parada antes de provar a otimalidade
+    StopReason stop = cb_data.stop;
+    if (err == GLP_ETMLIM) {
+        stop = STOP_TIME;
+    } else if (err == GLP_EMIPGAP) {
+        stop = STOP_GAP;
+    }
+    int stopped = err == GLP_ETMLIM || err == GLP_EMIPGAP || err == GLP_ESTOP;
+
     // Define status da solução
     const char* status_str;
-    if (err == 0) {
-        // Verifica se a solução é ótima
-        if (glp_mip_status(prob) == GLP_OPT) {
-            status_str = "Solução ótima encontrada";
-            fprintf(log_file, "Solução ótima encontrada!\n");
-        } else {
-            // Se não é ótima, é viável
-            status_str = "Solução viável (não ótima)";
-            fprintf(log_file, "Solução viável encontrada (não ótima)\n");
-        }
-        
-        // Define a solução como viável
+    if (err == 0 && glp_mip_status(prob) == GLP_OPT) {
+        status_str = "Solução ótima encontrada";
+        write_log("Solução ótima encontrada!\n");
+        solucao->optimal = 1;
         solucao->feasible = 1;
-        // Atualiza o custo da solução
         solucao->cost = glp_mip_obj_val(prob);
         
         // Reconstrói a rota a partir das variáveis x[i][j]
-        fprintf(log_file, "\nRota encontrada:\n");
+        write_log("\nRota encontrada:\n");
         int atual = 0;
         for (int i = 0; i < n; i++) {
             // Define a cidade atual como a cidade i
             solucao->route[i] = atual;
-            fprintf(log_file, "%d: %s\n", i+1, inst->houses[atual].name);
+            write_log("%d: %s\n", i+1, inst->houses[atual].name);
             // Encontra a próxima cidade a visitar
             for (int j = 0; j < n; j++) {
                 // Verifica se a cidade j é diferente da cidade atual
-                if (atual != j && glp_mip_col_val(prob, atual * n + j + 1) > 0.5) {
+                if (atual != j && glp_mip_col_val(prob, mip_x_col(n, atual, j)) > 0.5) {
                     atual = j;
                     break;
                 }
             }
         }
         
-        // Calcula gap usando bound da relaxação
-        double ub = solucao->cost;  // Upper bound (solução inteira)
-        solucao->gap = ((ub - lb) / ub) * 100.0;
-        
-        fprintf(log_file, "\nSolução encontrada:\n");
-        fprintf(log_file, "  Lower bound (relaxação): %.2f\n", lb);
-        fprintf(log_file, "  Upper bound (inteira): %.2f\n", ub);
-        fprintf(log_file, "  Gap: %.2f%%\n", solucao->gap);
-    } else if (solucao->time >= 600.0) {
-        status_str = "Tempo limite excedido";
-        fprintf(log_file, "Tempo limite de 600 segundos atingido!\n");
-        if (glp_mip_status(prob) == GLP_FEAS) {
-            status_str = "Solução viável encontrada antes do timeout";
-            fprintf(log_file, "Solução viável encontrada antes do timeout\n");
+        // Árvore esgotada: o limite inferior é a própria solução
+        lb = solucao->cost;
+        solucao->gap = 0.0;
+    } else if (stopped || err == 0) {
+        write_log("Busca encerrada: %s\n", stop_reason_text(stop));
+        status_str = "Sem solução viável";
+        if (glp_mip_status(prob) == GLP_FEAS &&
+            mip_extract_route(prob, n, glp_mip_col_val, solucao->route)) {
+            status_str = "Solução viável (não ótima)";
             solucao->feasible = 1;
             solucao->cost = glp_mip_obj_val(prob);
+            solucao->gap = lb > 0 ? ((solucao->cost - lb) / solucao->cost) * 100.0 : 100.0;
         }
     } else {
         status_str = "Erro na otimização";
-        fprintf(log_file, "Erro na otimização MIP: %d\n", err);
+        write_log_at(LOG_ERROR, "Erro na otimização MIP: %d\n", err);
+    }
+    if (solucao->feasible) {
+        write_log("\nSolução encontrada:\n");
+        write_log("  Limite inferior (melhor nó): %.2f\n", lb);
+        write_log("  Limite superior (inteira): %.2f\n", solucao->cost);
+        write_log("  Gap: %.2f%%\n", solucao->gap);
+    }
+    
+    // Sem solução do GLPK, a rota inicial continua sendo uma resposta viável
+    if (!solucao->feasible && heur_route) {
+        memcpy(solucao->route, heur_route, n * sizeof(int));
+        solucao->cost = heur_cost;
+        solucao->feasible = 1;
+        solucao->gap = lb > 0 ? ((heur_cost - lb) / heur_cost) * 100.0 : 100.0;
+        write_log("Usando a rota inicial: %.2f\n", heur_cost);
+        status_str = "Solução viável (rota inicial)";
     }
+    free(heur_route);
+    free(cb_data.shared_route);
+    free(cb_data.next);
+    free(cb_data.x);
+    free(cb_data.w);
+    free(cb_data.key);
+    free(cb_data.owner);
+    free(cb_data.active);
+    free(cb_data.added);
+    free(cb_data.in_set);
+    free(cb_data.ind);
+    free(cb_data.val);
     
     // Libera memória
-    free(ia);
-    free(ja);
-    free(ar);
     glp_delete_prob(prob);
-    
-    write_log("PLI concluído. Custo: %.2f, Gap: %.2f%%\n", 
-              solucao->cost, solucao->gap);
-    close_log();
 
+    // Tempo total gasto, do início do método até aqui
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    solucao->time = (end_time.tv_sec - start_time.tv_sec) +
+                    (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+    telemetry_counters(telemetry, cb_data.nodes, -1, cb_data.peak_active);
+    telemetry_finish(telemetry, solucao);
+    
     // Registra resultados finais no log
-    fprintf(log_file, "\nResultados finais:\n");
-    fprintf(log_file, "Status: %s\n", status_str);
-    fprintf(log_file, "Custo: %.2f\n", solucao->cost);
-    fprintf(log_file, "Tempo: %.2f s\n", solucao->time);
-    fprintf(log_file, "Gap: %.2f%%\n", solucao->gap);
-    fprintf(log_file, "Viável: %s\n", solucao->feasible ? "Sim" : "Não");
+    write_log("\nResultados finais:\n");
+    write_log("Status: %s\n", status_str);
+    if (stop != STOP_NONE) {
+        write_log("Parada: %s\n", stop_reason_text(stop));
+    }
+    write_log("Custo: %.2f\n", solucao->cost);
+    write_log("Tempo: %.2f s\n", solucao->time);
+    write_log("Gap: %.2f%%\n", solucao->gap);
+    write_log("Viável: %s\n", solucao->feasible ? "Sim" : "Não");
     
-    fprintf(log_file, "\nRota encontrada:\n");
+    write_log("\nRota encontrada:\n");
     for (int i = 0; i < inst->n; i++) {
-        fprintf(log_file, "%s ", inst->houses[solucao->route[i]].name);
+        write_log("%s ", inst->houses[solucao->route[i]].name);
     }
-    fprintf(log_file, "\n");
+    write_log("\n");
     
     // Adiciona explicação de viabilidade
-    explain_feasibility(inst, solucao, log_file);
+    explain_feasibility(inst, solucao);
     
-    fclose(log_file);
+    close_log();
     return solucao;
-} 
\ No newline at end of file
+}
+
+// Monta o modelo inicial (MTZ ou só graus) e o descarta; retorna o número
+// de não nulos (micro-benchmark da montagem)
+int mip_bench_build(const Instance* inst, int mtz) {
+    glp_prob* prob = glp_create_prob();
+    MipModelSize size = mip_build_model(prob, inst, mtz, config.mip_names);
+    glp_delete_prob(prob);
+    return size.nnz;
+}
+
+// O GLPK guarda seu ambiente em armazenamento local de thread quando foi
+// compilado com TLS; sem isso duas threads não podem resolver ao mesmo tempo
+int mip_thread_safe(void) {
+    return glp_config("TLS") != NULL;
+}
+
+// Libera o ambiente do GLPK da thread atual (fim de uma thread do modo lote)
+void mip_thread_done(void) {
+    glp_free_env();
+}
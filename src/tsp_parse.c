@@ -0,0 +1,341 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/**
+ * Leitura do formato texto de instâncias
+ *
+ * O arquivo é lido inteiro para um buffer terminado em '\0' e percorrido
+ * uma única vez por um leitor próprio de inteiros e reais, sem fscanf. O
+ * '\0' final não é espaço nem dígito, então os laços do leitor param nele
+ * sem comparar com o fim do buffer a cada caractere. As matrizes de
+ * distância e risco ficam em blocos contíguos (dist[i] e risk[i] apontam
+ * para as linhas) e a matriz de custos é preenchida junto com a leitura
+ * dos riscos.
+ *
+ * Erros de formato (número inválido, nome longo demais, arquivo truncado,
+ * conteúdo depois das matrizes) são informados com linha e coluna.
+ */
+
+// Posição de leitura no arquivo
+typedef struct {
+    const char* p;          // Próximo caractere
+    const char* end;        // Fim do arquivo (sempre aponta para um '\0')
+    const char* line_start; // Início da linha atual
+    int line;               // Linha atual (a partir de 1)
+    const char* filename;
+} Scanner;
+
+// Potências de 10 exatas em double
+static const double pow10_exact[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline int is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Fim de um número: espaço ou o '\0' do fim do buffer
+static inline int is_delim(char c) {
+    return c == '\0' || is_space(c);
+}
+
+static inline int is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Pula espaços e quebras de linha, contando as linhas
+static inline void skip_space(Scanner* s) {
+    const char* p = s->p;
+    while (is_space(*p)) {
+        if (*p == '\n') {
+            s->line++;
+            s->line_start = p + 1;
+        }
+        p++;
+    }
+    s->p = p;
+}
+
+// Informa erro na posição atual, mostrando a palavra encontrada
+static void scan_error(const Scanner* s, const char* expected) {
+    int column = (int)(s->p - s->line_start) + 1;
+    if (s->p >= s->end) {
+        fprintf(stderr, "%s:%d:%d: esperava %s, encontrou o fim do arquivo\n",
+                s->filename, s->line, column, expected);
+        return;
+    }
+    int len = 0;
+    while (!is_delim(s->p[len]) && len < 40) {
+        len++;
+    }
+    fprintf(stderr, "%s:%d:%d: esperava %s, encontrou '%.*s'\n",
+            s->filename, s->line, column, expected, len, s->p);
+}
+
+// Lê um inteiro com sinal opcional. Retorna 0 em caso de erro
+static int scan_int(Scanner* s, int* out, const char* what) {
+    skip_space(s);
+    const char* p = s->p;
+    int negative = 0;
+    if (*p == '-' || *p == '+') {
+        negative = *p == '-';
+        p++;
+    }
+    if (!is_digit(*p)) {
+        scan_error(s, what);
+        return 0;
+    }
+    long long value = 0;
+    while (is_digit(*p)) {
+        value = value * 10 + (*p - '0');
+        if (value > INT32_MAX) {
+            scan_error(s, what);
+            return 0;
+        }
+        p++;
+    }
+    if (!is_delim(*p)) {
+        scan_error(s, what);
+        return 0;
+    }
+    *out = (int)(negative ? -value : value);
+    s->p = p;
+    return 1;
+}
+
+// Lê um real (sinal, dígitos, parte decimal e expoente opcionais).
+// Com até 19 dígitos significativos e expoente decimal em [-22, 22] o
+// valor é uma única multiplicação ou divisão exata, com o mesmo resultado
+// de strtod; fora disso usa strtod. Retorna 0 em caso de erro
+static int scan_double(Scanner* s, double* out, const char* what) {
+    skip_space(s);
+    const char* start = s->p;
+    const char* p = start;
+    int negative = 0;
+    if (*p == '-' || *p == '+') {
+        negative = *p == '-';
+        p++;
+    }
+
+    // A mantissa acumula todos os dígitos; se passar de 19 ela pode ter
+    // estourado e o valor é refeito por strtod
+    uint64_t mantissa = 0;
+    const char* digits_start = p;
+    while (is_digit(*p)) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    int digits = (int)(p - digits_start);
+    int exponent = 0;       // Expoente decimal a aplicar à mantissa
+    if (*p == '.') {
+        const char* frac_start = ++p;
+        while (is_digit(*p)) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            p++;
+        }
+        exponent = -(int)(p - frac_start);
+        digits -= exponent;
+    }
+    int any = digits > 0;   // Algum dígito lido
+    int exact = digits <= 19;
+    if (any && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        int exp_negative = 0;
+        if (*q == '-' || *q == '+') {
+            exp_negative = *q == '-';
+            q++;
+        }
+        if (is_digit(*q)) {
+            int e = 0;
+            while (is_digit(*q)) {
+                if (e < 100000) e = e * 10 + (*q - '0');
+                q++;
+            }
+            exponent += exp_negative ? -e : e;
+            p = q;
+        }
+    }
+    if (!any || !is_delim(*p)) {
+        scan_error(s, what);
+        return 0;
+    }
+
+    double value;
+    if (exact && mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        value = (double)mantissa;
+        value = exponent < 0 ? value / pow10_exact[-exponent] : value * pow10_exact[exponent];
+        if (negative) value = -value;
+    } else {
+        // Caso raro: copia o número para um buffer terminado em '\0'
+        char buffer[128];
+        size_t len = (size_t)(p - start);
+        if (len >= sizeof(buffer)) {
+            scan_error(s, what);
+            return 0;
+        }
+        memcpy(buffer, start, len);
+        buffer[len] = '\0';
+        value = strtod(buffer, NULL);
+    }
+    *out = value;
+    s->p = p;
+    return 1;
+}
+
+// Lê uma palavra (nome de casa) para dest, com no máximo size - 1 caracteres
+static int scan_word(Scanner* s, char* dest, size_t size, const char* what) {
+    skip_space(s);
+    const char* p = s->p;
+    while (!is_delim(*p)) {
+        p++;
+    }
+    size_t len = (size_t)(p - s->p);
+    if (len == 0 || len >= size) {
+        scan_error(s, what);
+        return 0;
+    }
+    memcpy(dest, s->p, len);
+    dest[len] = '\0';
+    s->p = p;
+    return 1;
+}
+
+// Aloca uma matriz n x n alinhada a COST_MATRIX_ALIGN
+static double* alloc_matrix(size_t cells) {
+    void* mem = NULL;
+    if (posix_memalign(&mem, COST_MATRIX_ALIGN, cells * sizeof(double)) != 0) {
+        return NULL;
+    }
+    return (double*)mem;
+}
+
+// Libera uma instância parcialmente lida
+static void discard(Instance* inst) {
+    if (inst->dist) free(inst->dist[0]);
+    if (inst->risk) free(inst->risk[0]);
+    free(inst->dist);
+    free(inst->risk);
+    free(inst->houses);
+    free(inst->cost);
+    free(inst);
+}
+
+// Lê as casas e as matrizes a partir do scanner
+static Instance* parse_instance(Scanner* s) {
+    int n;
+    if (!scan_int(s, &n, "o número de cidades")) {
+        return NULL;
+    }
+    if (n <= 0 || n > MAX_CITIES) {
+        fprintf(stderr, "%s:%d: número de cidades inválido: %d\n", s->filename, s->line, n);
+        return NULL;
+    }
+
+    Instance* inst = (Instance*)calloc(1, sizeof(Instance));
+    inst->n = n;
+    size_t cells = (size_t)n * n;
+    inst->houses = (House*)malloc(n * sizeof(House));
+    inst->dist = (double**)malloc(n * sizeof(double*));
+    inst->risk = (double**)malloc(n * sizeof(double*));
+    double* dist = alloc_matrix(cells);
+    double* risk = alloc_matrix(cells);
+    inst->cost = alloc_matrix(cells);
+    if (!inst->houses || !inst->dist || !inst->risk || !dist || !risk || !inst->cost) {
+        fprintf(stderr, "Memória insuficiente para a instância (%d cidades)\n", n);
+        free(dist);
+        free(risk);
+        free(inst->dist);
+        free(inst->risk);
+        inst->dist = inst->risk = NULL;
+        discard(inst);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        inst->dist[i] = dist + (size_t)i * n;
+        inst->risk[i] = risk + (size_t)i * n;
+    }
+
+    // Casas: nome, poder, lealdade, tempo mínimo
+    for (int i = 0; i < n; i++) {
+        House* h = &inst->houses[i];
+        if (!scan_word(s, h->name, sizeof(h->name), "o nome da casa") ||
+            !scan_int(s, &h->power, "o poder da casa (inteiro)") ||
+            !scan_double(s, &h->loyalty, "a lealdade da casa (real)") ||
+            !scan_int(s, &h->min_time, "o tempo mínimo da casa (inteiro)")) {
+            discard(inst);
+            return NULL;
+        }
+    }
+
+    for (size_t k = 0; k < cells; k++) {
+        if (!scan_double(s, &dist[k], "uma distância (real)")) {
+            discard(inst);
+            return NULL;
+        }
+    }
+
+    // Riscos, com o custo de cada arco calculado na mesma passada
+    for (size_t k = 0; k < cells; k++) {
+        if (!scan_double(s, &risk[k], "um risco (real)")) {
+            discard(inst);
+            return NULL;
+        }
+        inst->cost[k] = dist[k] * (1.0 + risk[k]);
+    }
+
+    skip_space(s);
+    if (s->p < s->end) {
+        scan_error(s, "o fim do arquivo depois da matriz de riscos");
+        discard(inst);
+        return NULL;
+    }
+    return inst;
+}
+
+// Lê instância no formato texto
+Instance* read_instance_text(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro ao abrir arquivo %s\n", filename);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        fprintf(stderr, "%s: arquivo vazio\n", filename);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    char* buffer = (char*)malloc(size + 1);
+    size_t done = 0;
+    while (buffer && done < size) {
+        ssize_t got = read(fd, buffer + done, size - done);
+        if (got <= 0) break;
+        done += (size_t)got;
+    }
+    close(fd);
+    if (!buffer || done != size) {
+        printf("Erro ao ler arquivo %s\n", filename);
+        free(buffer);
+        return NULL;
+    }
+    buffer[size] = '\0';
+
+    Scanner s;
+    s.p = buffer;
+    s.end = buffer + size;
+    s.line_start = buffer;
+    s.line = 1;
+    s.filename = filename;
+    Instance* inst = parse_instance(&s);
+
+    free(buffer);
+    return inst;
+}
@@ -0,0 +1,413 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+ * Seleção do método em tempo de execução e portfólio de métodos
+ *
+ * solve_engine despacha para o método pedido em --engine; todos os métodos
+ * ficam no mesmo executável (o PLI só quando compilado com o GLPK).
+ *
+ * No portfólio (--portfolio) cada método roda em uma thread sobre a mesma
+ * instância e todos compartilham a melhor rota conhecida e o maior limite
+ * inferior publicado. Cada thread se associa ao portfólio com
+ * portfolio_attach, e os métodos usam as funções portfolio_* sem receber o
+ * portfólio como parâmetro (fora dele elas não fazem nada):
+ * - portfolio_offer: publica uma rota nova
+ * - portfolio_fetch: copia a rota compartilhada se ela é melhor que a local
+ * - portfolio_bound: publica um limite inferior válido para a instância
+ * - portfolio_stopped: indica que todos devem parar
+ * A parada é sinalizada quando um método termina provando a otimalidade
+ * (ou o gap alvo) ou quando a melhor rota e o maior limite, vindos de
+ * métodos diferentes, ficam dentro do gap alvo (--gap, ou
+ * PORTFOLIO_TARGET_GAP). O tempo do portfólio é o tempo até essa parada.
+ *
+ * Os limites de cada execução (--time-limit, --node-limit, --mem-limit) e a
+ * parada pedida por SIGINT/SIGTERM também são consultados aqui, por
+ * limit_reached e memory_limit_reached; cada método encerra a busca e
+ * devolve a melhor rota que tiver.
+ */
+
+// Gap alvo padrão do portfólio em %
+#define PORTFOLIO_TARGET_GAP 1.0
+
+// Estado compartilhado entre os métodos do portfólio
+struct Portfolio {
+    const Instance* inst;
+    pthread_mutex_t lock;           // Protege route, owner e found_at
+    int* route;                     // Melhor rota conhecida
+    _Atomic double incumbent;       // Custo de route (DBL_MAX se ainda não há)
+    _Atomic double lower_bound;     // Maior limite inferior publicado
+    atomic_int stop;                // Otimalidade provada ou gap alvo atingido
+    Engine owner;                   // Método que encontrou route
+    double found_at;                // Tempo (s) em que route foi encontrada
+    double stop_at;                 // Tempo (s) da parada (0 se não houve)
+    struct timespec start;
+};
+
+// Portfólio e método da thread atual (NULL fora do portfólio)
+static _Thread_local Portfolio* current = NULL;
+static _Thread_local Engine current_engine = ENGINE_BB;
+
+// Nomes dos métodos usados na saída, na ordem de Engine
+static const char* engine_titles[] = {
+    "Branch and Bound", "PLI", "Programação Dinâmica", "Lin-Kernighan (heurística)"
+};
+
+const char* engine_title(Engine engine) {
+    return engine_titles[engine];
+}
+
+// O PLI depende do GLPK; os demais métodos estão sempre disponíveis
+int engine_available(Engine engine) {
+#ifdef NO_GLPK
+    return engine != ENGINE_MIP;
+#else
+    (void)engine;
+    return 1;
+#endif
+}
+
+// Resolve a instância com um método
+Solution* solve_engine(Engine engine, const Instance* inst, const char* nome_arquivo,
+                       const int* initial_route) {
+    Solution* sol = NULL;
+    switch (engine) {
+        case ENGINE_BB: sol = solve_bb(inst, nome_arquivo); break;
+        case ENGINE_DP: sol = solve_dp(inst, nome_arquivo); break;
+        case ENGINE_LK: sol = solve_lk(inst, nome_arquivo); break;
+        case ENGINE_MIP: {
+#ifdef NO_GLPK
+            (void)initial_route;
+            fprintf(stderr, "PLI indisponível: compilado sem o GLPK (NO_GLPK)\n");
+#else
+            sol = solve_mip(inst, nome_arquivo, initial_route);
+#endif
+            break;
+        }
+        default: break;
+    }
+    if (sol) {
+        sol->engine = engine;
+    }
+    return sol;
+}
+
+// Converte uma lista de métodos separados por vírgula ("bb,mip,lk").
+// Retorna quantos métodos foram lidos, ou 0 se algum nome não existe ou se repete
+int parse_engine_list(const char* list, Engine* engines) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%s", list);
+    int count = 0;
+    for (char* name = strtok(buffer, ","); name; name = strtok(NULL, ",")) {
+        Engine engine;
+        if (count == ENGINE_COUNT || !parse_engine(name, &engine)) {
+            return 0;
+        }
+        for (int k = 0; k < count; k++) {
+            if (engines[k] == engine) return 0;
+        }
+        engines[count++] = engine;
+    }
+    return count;
+}
+
+// Os métodos podem rodar em várias threads ao mesmo tempo (o PLI só se o
+// GLPK foi compilado com TLS)
+int engines_thread_safe(const Engine* engines, int count) {
+#ifndef NO_GLPK
+    for (int k = 0; k < count; k++) {
+        if (engines[k] == ENGINE_MIP) {
+            return mip_thread_safe();
+        }
+    }
+#else
+    (void)engines;
+    (void)count;
+#endif
+    return 1;
+}
+
+// Libera o que os métodos guardam por thread (ambiente do GLPK)
+void engine_thread_done(void) {
+#ifndef NO_GLPK
+    mip_thread_done();
+#endif
+}
+
+static double portfolio_elapsed(const Portfolio* pf) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - pf->start.tv_sec) + (now.tv_nsec - pf->start.tv_nsec) / 1e9;
+}
+
+// Sinaliza a parada de todos os métodos (só a primeira vez conta)
+static void portfolio_signal_stop(Portfolio* pf) {
+    if (!atomic_exchange(&pf->stop, 1)) {
+        pf->stop_at = portfolio_elapsed(pf);
+    }
+}
+
+// Para se a melhor rota e o maior limite estão dentro do gap alvo
+static void portfolio_check_gap(Portfolio* pf) {
+    double incumbent = atomic_load(&pf->incumbent);
+    double bound = atomic_load(&pf->lower_bound);
+    if (incumbent < DBL_MAX && bound > 0 &&
+        (incumbent - bound) / incumbent * 100.0 <= target_gap(PORTFOLIO_TARGET_GAP)) {
+        portfolio_signal_stop(pf);
+    }
+}
+
+Portfolio* portfolio_current(void) {
+    return current;
+}
+
+// Associa a thread atual ao portfólio, em nome de um método
+void portfolio_attach(Portfolio* pf, Engine engine) {
+    current = pf;
+    current_engine = engine;
+}
+
+// Publica uma rota completa (começando na cidade 0) com seu custo total.
+// Retorna 1 se ela passou a ser a melhor do portfólio
+int portfolio_offer(const int* route, double cost) {
+    Portfolio* pf = current;
+    if (!pf || cost >= atomic_load(&pf->incumbent)) {
+        return 0;
+    }
+    pthread_mutex_lock(&pf->lock);
+    int improved = cost < atomic_load(&pf->incumbent);
+    if (improved) {
+        memcpy(pf->route, route, pf->inst->n * sizeof(int));
+        pf->owner = current_engine;
+        pf->found_at = portfolio_elapsed(pf);
+        atomic_store(&pf->incumbent, cost);
+    }
+    pthread_mutex_unlock(&pf->lock);
+    if (improved) {
+        portfolio_check_gap(pf);
+    }
+    return improved;
+}
+
+// Copia a rota compartilhada para route se ela custa menos que *cost.
+// Retorna 1 se copiou (e atualiza *cost)
+int portfolio_fetch(int* route, double* cost) {
+    Portfolio* pf = current;
+    if (!pf || atomic_load(&pf->incumbent) >= *cost) {
+        return 0;
+    }
+    pthread_mutex_lock(&pf->lock);
+    double shared = atomic_load(&pf->incumbent);
+    int better = shared < *cost;
+    if (better) {
+        memcpy(route, pf->route, pf->inst->n * sizeof(int));
+        *cost = shared;
+    }
+    pthread_mutex_unlock(&pf->lock);
+    return better;
+}
+
+// Custo da melhor rota do portfólio (DBL_MAX fora dele ou sem rota)
+double portfolio_incumbent(void) {
+    return current ? atomic_load(&current->incumbent) : DBL_MAX;
+}
+
+// Publica um limite inferior do custo ótimo
+void portfolio_bound(double bound) {
+    Portfolio* pf = current;
+    if (!pf) return;
+    double old = atomic_load(&pf->lower_bound);
+    while (bound > old && !atomic_compare_exchange_weak(&pf->lower_bound, &old, bound)) {
+    }
+    portfolio_check_gap(pf);
+}
+
+int portfolio_stopped(void) {
+    return current && atomic_load_explicit(&current->stop, memory_order_relaxed);
+}
+
+// Parada pedida por SIGINT/SIGTERM (o tratador do sinal só grava o atômico)
+static atomic_int stop_signal;
+
+void request_stop(void) {
+    atomic_store(&stop_signal, 1);
+}
+
+int stop_requested(void) {
+    return atomic_load_explicit(&stop_signal, memory_order_relaxed);
+}
+
+// Limite atingido por um método em execução: sinal, parada do portfólio,
+// tempo (elapsed em s) ou nós explorados (nodes < 0 se o método não os conta)
+StopReason limit_reached(double elapsed, long long nodes) {
+    if (stop_requested()) return STOP_SIGNAL;
+    if (portfolio_stopped()) return STOP_PORTFOLIO;
+    if (elapsed >= config.time_limit) return STOP_TIME;
+    if (config.node_limit > 0 && nodes >= config.node_limit) return STOP_NODES;
+    return STOP_NONE;
+}
+
+// Memória residente acima de --mem-limit. Lê /proc: os métodos só a
+// consultam de tempos em tempos
+int memory_limit_reached(void) {
+    return config.mem_limit_mb > 0 &&
+           current_rss_kb() > (long)config.mem_limit_mb * 1024;
+}
+
+// Gap alvo (%): o de --gap ou, sem ele, o padrão do método
+double target_gap(double engine_default) {
+    return config.target_gap >= 0.0 ? config.target_gap : engine_default;
+}
+
+// Um método do portfólio em execução
+typedef struct {
+    Portfolio* pf;
+    Engine engine;
+    const Instance* inst;
+    const char* nome_arquivo;
+    const int* initial_route;
+    pthread_t thread;
+    Solution* sol;
+} PortfolioTask;
+
+static void* portfolio_run(void* arg) {
+    PortfolioTask* task = (PortfolioTask*)arg;
+    portfolio_attach(task->pf, task->engine);
+    task->sol = solve_engine(task->engine, task->inst, task->nome_arquivo,
+                             task->initial_route);
+    Solution* sol = task->sol;
+    if (sol && sol->feasible) {
+        portfolio_offer(sol->route, sol->cost);
+        if (sol->optimal && !portfolio_stopped()) {
+            portfolio_signal_stop(task->pf);
+        }
+    }
+    portfolio_attach(NULL, ENGINE_BB);
+    engine_thread_done();
+    return NULL;
+}
+
+// Resolve a instância com vários métodos ao mesmo tempo, uma thread por
+// método, e devolve a melhor rota. Cada método mantém o próprio log
+Solution* solve_portfolio(const Instance* inst, const char* nome_arquivo,
+                          const int* initial_route, const Engine* engines, int count) {
+    int n = inst->n;
+    Portfolio pf;
+    pf.inst = inst;
+    pthread_mutex_init(&pf.lock, NULL);
+    pf.route = (int*)malloc(n * sizeof(int));
+    atomic_init(&pf.incumbent, DBL_MAX);
+    atomic_init(&pf.lower_bound, 0.0);
+    atomic_init(&pf.stop, 0);
+    pf.owner = engines[0];
+    pf.found_at = 0.0;
+    pf.stop_at = 0.0;
+    clock_gettime(CLOCK_MONOTONIC, &pf.start);
+
+    PortfolioTask* tasks = (PortfolioTask*)calloc(count, sizeof(PortfolioTask));
+    for (int k = 0; k < count; k++) {
+        tasks[k].pf = &pf;
+        tasks[k].engine = engines[k];
+        tasks[k].inst = inst;
+        tasks[k].nome_arquivo = nome_arquivo;
+        tasks[k].initial_route = initial_route;
+        pthread_create(&tasks[k].thread, NULL, portfolio_run, &tasks[k]);
+    }
+    for (int k = 0; k < count; k++) {
+        pthread_join(tasks[k].thread, NULL);
+    }
+    double elapsed = portfolio_elapsed(&pf);
+
+    // Sem rota de nenhum método: resultado inviável, como o de um método só
+    Solution* best = (Solution*)malloc(sizeof(Solution));
+    best->route = pf.route;
+    pf.route = NULL;
+    best->engine = pf.owner;
+    best->total_time = 0;
+    best->optimal = 0;
+    if (atomic_load(&pf.incumbent) >= DBL_MAX) {
+        for (int i = 0; i < n; i++) {
+            best->route[i] = -1;
+        }
+        best->cost = DBL_MAX;
+        best->feasible = 0;
+        best->gap = 100.0;
+        best->time = elapsed;
+    } else {
+        best->cost = atomic_load(&pf.incumbent);
+        best->feasible = 1;
+        for (int i = 0; i < n; i++) {
+            best->total_time += inst->houses[i].min_time;
+        }
+        best->time = atomic_load(&pf.stop) ? pf.stop_at : elapsed;
+        // Ótima só se algum método provou a otimalidade; uma parada no gap
+        // alvo aparece no gap e no motivo da parada. O limite de cada método
+        // vem do seu gap final (ex.: PLI no gap alvo, que não o publica)
+        double bound = atomic_load(&pf.lower_bound);
+        for (int k = 0; k < count; k++) {
+            Solution* sol = tasks[k].sol;
+            if (!sol || !sol->feasible) continue;
+            if (sol->optimal) {
+                best->optimal = 1;
+            }
+            double engine_bound = sol->cost * (1.0 - sol->gap / 100.0);
+            if (sol->gap < 100.0 && engine_bound > bound) {
+                bound = engine_bound;
+            }
+        }
+        if (best->optimal) {
+            best->gap = 0.0;
+        } else {
+            best->gap = bound > 0 ? (best->cost - bound) / best->cost * 100.0 : 100.0;
+            if (best->gap < 0) best->gap = 0.0;
+        }
+    }
+
+    // Resumo dos métodos no log do portfólio, na ordem pedida
+    char instance_name[256];
+    instance_base_name(nome_arquivo, instance_name, sizeof(instance_name));
+    char log_filename[300];
+    snprintf(log_filename, sizeof(log_filename), "logs/%s_PF.log", instance_name);
+    open_log(log_filename);
+    write_log("=== Portfólio de métodos para TSP ===\n");
+    write_log("Instância: %s\n", instance_name);
+    write_log("Número de cidades: %d\n\n", n);
+    for (int k = 0; k < count; k++) {
+        Solution* sol = tasks[k].sol;
+        if (!sol || !sol->feasible) {
+            write_log("%-4s sem solução\n", engine_name(engines[k]));
+        } else {
+            write_log("%-4s custo %.2f, gap %.2f%%, %.2f s%s\n", engine_name(engines[k]),
+                      sol->cost, sol->gap, sol->time, sol->optimal ? " (ótimo)" : "");
+        }
+        free_solution(sol);
+    }
+    write_log("\nLimite inferior compartilhado: %.2f\n", atomic_load(&pf.lower_bound));
+    if (best->feasible) {
+        write_log("Melhor rota: %s, encontrada em %.2f s\n",
+                  engine_name(best->engine), pf.found_at);
+        write_log("Custo: %.2f\n", best->cost);
+        write_log("Gap: %.2f%%\n", best->gap);
+    }
+    const char* reason = "todos os métodos terminaram";
+    if (best->optimal) {
+        reason = "otimalidade provada";
+    } else if (atomic_load(&pf.stop)) {
+        reason = stop_reason_text(STOP_GAP);
+    } else if (stop_requested()) {
+        reason = stop_reason_text(STOP_SIGNAL);
+    }
+    write_log("Parada: %s em %.2f s\n", reason, atomic_load(&pf.stop) ? pf.stop_at : elapsed);
+    close_log();
+
+    free(tasks);
+    free(pf.route);
+    pthread_mutex_destroy(&pf.lock);
+    return best;
+}
@@ -0,0 +1,413 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TSP_SIMD_X86 1
+#endif
+
+/**
+ * Kernels vetorizados para os laços internos dos limites e do custo da rota
+ *
+ * Cada kernel tem uma versão escalar e versões SSE2, AVX2 e AVX-512 (apenas
+ * em x86), compiladas com atributos de target para não exigir flags globais.
+ * simd_init escolhe a melhor versão suportada pela CPU (cpuid) ou a versão
+ * forçada na compilação com -DTSP_SIMD_FORCE="scalar|sse2|avx2|avx512".
+ *
+ * Convenções:
+ * - mask (opcional): posições com mask[j] != 0 são ignoradas (ex.: visited)
+ * - skip: índice ignorado (-1 para nenhum)
+ * - sem posições válidas o mínimo é DBL_MAX e arg1 é -1
+ */
+
+// ---------------------------------------------------------------------------
+// Versões escalares
+// ---------------------------------------------------------------------------
+
+static double masked_min_scalar(const double* row, const int* mask, int n, int skip) {
+    double best = DBL_MAX;
+    for (int j = 0; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        best = (row[j] < best) ? row[j] : best;
+    }
+    return best;
+}
+
+static void two_min_scalar(const double* row, const int* mask, int n, int skip,
+                           double* min1, double* min2, int* arg1) {
+    double b1 = DBL_MAX, b2 = DBL_MAX;
+    int a1 = -1;
+    for (int j = 0; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        double cost = row[j];
+        if (cost < b1) {
+            b2 = b1;
+            b1 = cost;
+            a1 = j;
+        } else if (cost < b2) {
+            b2 = cost;
+        }
+    }
+    *min1 = b1;
+    *min2 = b2;
+    *arg1 = a1;
+}
+
+static double tour_sum_scalar(const double* cost, int n, const int* route) {
+    double sum = 0.0;
+    for (int i = 0; i < n-1; i++) {
+        sum += cost[route[i] * n + route[i+1]];
+    }
+    return sum + cost[route[n-1] * n];
+}
+
+// Combina os mínimos parciais de cada lane em (min1, min2, arg1)
+static void merge_lanes(const double* m1, const double* m2, const long long* a1,
+                        int lanes, double* min1, double* min2, int* arg1) {
+    double b1 = DBL_MAX, b2 = DBL_MAX;
+    int best = -1;
+    for (int l = 0; l < lanes; l++) {
+        if (m1[l] < b1) {
+            b2 = b1;
+            b1 = m1[l];
+            best = (int)a1[l];
+        } else if (m1[l] < b2) {
+            b2 = m1[l];
+        }
+        b2 = (m2[l] < b2) ? m2[l] : b2;
+    }
+    *min1 = b1;
+    *min2 = b2;
+    *arg1 = best;
+}
+
+// Atualiza (min1, min2, arg1) com o elemento j tratado fora do laço vetorial
+static void two_min_tail(double cost, int j, double* b1, double* b2, int* a1) {
+    if (cost < *b1) {
+        *b2 = *b1;
+        *b1 = cost;
+        *a1 = j;
+    } else if (cost < *b2) {
+        *b2 = cost;
+    }
+}
+
+#ifdef TSP_SIMD_X86
+
+// ---------------------------------------------------------------------------
+// SSE2: 2 doubles por iteração
+// ---------------------------------------------------------------------------
+
+// Máscara de 64 bits por lane (todos 1 = posição válida) para 2 posições
+__attribute__((target("sse2")))
+static __m128d valid_mask_sse2(const int* mask, int j, __m128i idx, __m128i skip) {
+    __m128i valid = _mm_set1_epi32(-1);
+    if (mask) {
+        __m128i m = _mm_loadl_epi64((const __m128i*)(mask + j));
+        __m128i z = _mm_cmpeq_epi32(m, _mm_setzero_si128());
+        valid = _mm_unpacklo_epi32(z, z);
+    }
+    // Compara índices (64 bits) com skip usando as metades de 32 bits
+    __m128i eq = _mm_cmpeq_epi32(idx, skip);
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    valid = _mm_andnot_si128(eq, valid);
+    return _mm_castsi128_pd(valid);
+}
+
+__attribute__((target("sse2")))
+static double masked_min_sse2(const double* row, const int* mask, int n, int skip) {
+    __m128d inf = _mm_set1_pd(DBL_MAX);
+    __m128d best = inf;
+    __m128i idx = _mm_set_epi64x(1, 0);
+    __m128i step = _mm_set1_epi64x(2);
+    __m128i vskip = _mm_set1_epi64x(skip);
+    int j = 0;
+    for (; j + 2 <= n; j += 2) {
+        __m128d v = _mm_loadu_pd(row + j);
+        __m128d valid = valid_mask_sse2(mask, j, idx, vskip);
+        v = _mm_or_pd(_mm_and_pd(valid, v), _mm_andnot_pd(valid, inf));
+        best = _mm_min_pd(best, v);
+        idx = _mm_add_epi64(idx, step);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, best);
+    double result = (lanes[0] < lanes[1]) ? lanes[0] : lanes[1];
+    for (; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        result = (row[j] < result) ? row[j] : result;
+    }
+    return result;
+}
+
+__attribute__((target("sse2")))
+static void two_min_sse2(const double* row, const int* mask, int n, int skip,
+                         double* min1, double* min2, int* arg1) {
+    __m128d inf = _mm_set1_pd(DBL_MAX);
+    __m128d m1 = inf, m2 = inf;
+    __m128i a1 = _mm_set1_epi64x(-1);
+    __m128i idx = _mm_set_epi64x(1, 0);
+    __m128i step = _mm_set1_epi64x(2);
+    __m128i vskip = _mm_set1_epi64x(skip);
+    int j = 0;
+    for (; j + 2 <= n; j += 2) {
+        __m128d v = _mm_loadu_pd(row + j);
+        __m128d valid = valid_mask_sse2(mask, j, idx, vskip);
+        v = _mm_or_pd(_mm_and_pd(valid, v), _mm_andnot_pd(valid, inf));
+        __m128d lt = _mm_cmplt_pd(v, m1);
+        // Se v < m1: m2 = m1; senão m2 = min(m2, v)
+        m2 = _mm_or_pd(_mm_and_pd(lt, m1), _mm_andnot_pd(lt, _mm_min_pd(m2, v)));
+        m1 = _mm_or_pd(_mm_and_pd(lt, v), _mm_andnot_pd(lt, m1));
+        __m128i lti = _mm_castpd_si128(lt);
+        a1 = _mm_or_si128(_mm_and_si128(lti, idx), _mm_andnot_si128(lti, a1));
+        idx = _mm_add_epi64(idx, step);
+    }
+    double l1[2], l2[2];
+    long long la[2];
+    _mm_storeu_pd(l1, m1);
+    _mm_storeu_pd(l2, m2);
+    _mm_storeu_si128((__m128i*)la, a1);
+    merge_lanes(l1, l2, la, 2, min1, min2, arg1);
+    for (; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        two_min_tail(row[j], j, min1, min2, arg1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2: 4 doubles por iteração
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static __m256d valid_mask_avx2(const int* mask, int j, __m256i idx, __m256i skip) {
+    __m256i valid = _mm256_set1_epi64x(-1);
+    if (mask) {
+        __m128i m = _mm_loadu_si128((const __m128i*)(mask + j));
+        valid = _mm256_cmpeq_epi64(_mm256_cvtepi32_epi64(m), _mm256_setzero_si256());
+    }
+    valid = _mm256_andnot_si256(_mm256_cmpeq_epi64(idx, skip), valid);
+    return _mm256_castsi256_pd(valid);
+}
+
+__attribute__((target("avx2")))
+static double masked_min_avx2(const double* row, const int* mask, int n, int skip) {
+    __m256d inf = _mm256_set1_pd(DBL_MAX);
+    __m256d best = inf;
+    __m256i idx = _mm256_set_epi64x(3, 2, 1, 0);
+    __m256i step = _mm256_set1_epi64x(4);
+    __m256i vskip = _mm256_set1_epi64x(skip);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d v = _mm256_loadu_pd(row + j);
+        __m256d valid = valid_mask_avx2(mask, j, idx, vskip);
+        best = _mm256_min_pd(best, _mm256_blendv_pd(inf, v, valid));
+        idx = _mm256_add_epi64(idx, step);
+    }
+    __m128d half = _mm_min_pd(_mm256_castpd256_pd128(best), _mm256_extractf128_pd(best, 1));
+    half = _mm_min_sd(half, _mm_unpackhi_pd(half, half));
+    double result = _mm_cvtsd_f64(half);
+    for (; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        result = (row[j] < result) ? row[j] : result;
+    }
+    return result;
+}
+
+__attribute__((target("avx2")))
+static void two_min_avx2(const double* row, const int* mask, int n, int skip,
+                         double* min1, double* min2, int* arg1) {
+    __m256d inf = _mm256_set1_pd(DBL_MAX);
+    __m256d m1 = inf, m2 = inf;
+    __m256i a1 = _mm256_set1_epi64x(-1);
+    __m256i idx = _mm256_set_epi64x(3, 2, 1, 0);
+    __m256i step = _mm256_set1_epi64x(4);
+    __m256i vskip = _mm256_set1_epi64x(skip);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d v = _mm256_loadu_pd(row + j);
+        __m256d valid = valid_mask_avx2(mask, j, idx, vskip);
+        v = _mm256_blendv_pd(inf, v, valid);
+        __m256d lt = _mm256_cmp_pd(v, m1, _CMP_LT_OQ);
+        m2 = _mm256_blendv_pd(_mm256_min_pd(m2, v), m1, lt);
+        m1 = _mm256_blendv_pd(m1, v, lt);
+        a1 = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(a1),
+                                                  _mm256_castsi256_pd(idx), lt));
+        idx = _mm256_add_epi64(idx, step);
+    }
+    double l1[4], l2[4];
+    long long la[4];
+    _mm256_storeu_pd(l1, m1);
+    _mm256_storeu_pd(l2, m2);
+    _mm256_storeu_si256((__m256i*)la, a1);
+    merge_lanes(l1, l2, la, 4, min1, min2, arg1);
+    for (; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        two_min_tail(row[j], j, min1, min2, arg1);
+    }
+}
+
+__attribute__((target("avx2")))
+static double tour_sum_avx2(const double* cost, int n, const int* route) {
+    __m256d acc = _mm256_setzero_pd();
+    __m128i vn = _mm_set1_epi32(n);
+    int i = 0;
+    // Índices route[i] * n + route[i+1] calculados 4 a 4 e lidos com gather
+    for (; i + 4 <= n-1; i += 4) {
+        __m128i from = _mm_loadu_si128((const __m128i*)(route + i));
+        __m128i to = _mm_loadu_si128((const __m128i*)(route + i + 1));
+        __m128i index = _mm_add_epi32(_mm_mullo_epi32(from, vn), to);
+        acc = _mm256_add_pd(acc, _mm256_i32gather_pd(cost, index, 8));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n-1; i++) {
+        sum += cost[route[i] * n + route[i+1]];
+    }
+    return sum + cost[route[n-1] * n];
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512: 8 doubles por iteração com máscaras de predicado
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx512f")))
+static __mmask8 valid_mask_avx512(const int* mask, int j, __m512i idx, __m512i skip) {
+    __mmask8 valid = 0xFF;
+    if (mask) {
+        __m256i m = _mm256_loadu_si256((const __m256i*)(mask + j));
+        valid = _mm512_cmpeq_epi64_mask(_mm512_cvtepi32_epi64(m), _mm512_setzero_si512());
+    }
+    return valid & ~_mm512_cmpeq_epi64_mask(idx, skip);
+}
+
+__attribute__((target("avx512f")))
+static double masked_min_avx512(const double* row, const int* mask, int n, int skip) {
+    __m512d best = _mm512_set1_pd(DBL_MAX);
+    __m512i idx = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    __m512i step = _mm512_set1_epi64(8);
+    __m512i vskip = _mm512_set1_epi64(skip);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __mmask8 valid = valid_mask_avx512(mask, j, idx, vskip);
+        best = _mm512_mask_min_pd(best, valid, best, _mm512_loadu_pd(row + j));
+        idx = _mm512_add_epi64(idx, step);
+    }
+    double result = _mm512_reduce_min_pd(best);
+    for (; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        result = (row[j] < result) ? row[j] : result;
+    }
+    return result;
+}
+
+__attribute__((target("avx512f")))
+static void two_min_avx512(const double* row, const int* mask, int n, int skip,
+                           double* min1, double* min2, int* arg1) {
+    __m512d m1 = _mm512_set1_pd(DBL_MAX), m2 = m1;
+    __m512i a1 = _mm512_set1_epi64(-1);
+    __m512i idx = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    __m512i step = _mm512_set1_epi64(8);
+    __m512i vskip = _mm512_set1_epi64(skip);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __mmask8 valid = valid_mask_avx512(mask, j, idx, vskip);
+        __m512d v = _mm512_loadu_pd(row + j);
+        __mmask8 lt = _mm512_mask_cmp_pd_mask(valid, v, m1, _CMP_LT_OQ);
+        // Lanes com v < m1 empurram m1 para m2; as demais fazem min(m2, v)
+        m2 = _mm512_mask_min_pd(m2, valid & ~lt, m2, v);
+        m2 = _mm512_mask_mov_pd(m2, lt, m1);
+        m1 = _mm512_mask_mov_pd(m1, lt, v);
+        a1 = _mm512_mask_mov_epi64(a1, lt, idx);
+        idx = _mm512_add_epi64(idx, step);
+    }
+    double l1[8], l2[8];
+    long long la[8];
+    _mm512_storeu_pd(l1, m1);
+    _mm512_storeu_pd(l2, m2);
+    _mm512_storeu_si512((void*)la, a1);
+    merge_lanes(l1, l2, la, 8, min1, min2, arg1);
+    for (; j < n; j++) {
+        if ((mask && mask[j]) || j == skip) continue;
+        two_min_tail(row[j], j, min1, min2, arg1);
+    }
+}
+
+__attribute__((target("avx512f")))
+static double tour_sum_avx512(const double* cost, int n, const int* route) {
+    __m512d acc = _mm512_setzero_pd();
+    __m256i vn = _mm256_set1_epi32(n);
+    int i = 0;
+    for (; i + 8 <= n-1; i += 8) {
+        __m256i from = _mm256_loadu_si256((const __m256i*)(route + i));
+        __m256i to = _mm256_loadu_si256((const __m256i*)(route + i + 1));
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(from, vn), to);
+        acc = _mm512_add_pd(acc, _mm512_i32gather_pd(index, cost, 8));
+    }
+    double sum = _mm512_reduce_add_pd(acc);
+    for (; i < n-1; i++) {
+        sum += cost[route[i] * n + route[i+1]];
+    }
+    return sum + cost[route[n-1] * n];
+}
+
+#endif // TSP_SIMD_X86
+
+// ---------------------------------------------------------------------------
+// Seleção em tempo de execução
+// ---------------------------------------------------------------------------
+
+// Kernels em uso; começa com a versão escalar para funcionar sem simd_init
+SimdKernels simd = {
+    "scalar", masked_min_scalar, two_min_scalar, tour_sum_scalar
+};
+
+// Tabela com todas as versões compiladas, da mais simples para a mais larga
+static const SimdKernels simd_variants[] = {
+    { "scalar", masked_min_scalar, two_min_scalar, tour_sum_scalar },
+#ifdef TSP_SIMD_X86
+    { "sse2",   masked_min_sse2,   two_min_sse2,   tour_sum_scalar },
+    { "avx2",   masked_min_avx2,   two_min_avx2,   tour_sum_avx2 },
+    { "avx512", masked_min_avx512, two_min_avx512, tour_sum_avx512 },
+#endif
+};
+
+// Verifica se a CPU suporta a versão pedida
+static int simd_supported(const char* name) {
+    if (strcmp(name, "scalar") == 0) return 1;
+#ifdef TSP_SIMD_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0) return __builtin_cpu_supports("sse2");
+    if (strcmp(name, "avx2") == 0) return __builtin_cpu_supports("avx2");
+    if (strcmp(name, "avx512") == 0) return __builtin_cpu_supports("avx512f");
+#endif
+    return 0;
+}
+
+// Escolhe os kernels: versão forçada na compilação ou a mais larga suportada
+void simd_init(void) {
+    int count = (int)(sizeof(simd_variants) / sizeof(simd_variants[0]));
+
+#ifdef TSP_SIMD_FORCE
+    for (int i = 0; i < count; i++) {
+        if (strcmp(simd_variants[i].name, TSP_SIMD_FORCE) == 0) {
+            if (simd_supported(TSP_SIMD_FORCE)) {
+                simd = simd_variants[i];
+                return;
+            }
+            break;
+        }
+    }
+    fprintf(stderr, "Aviso: kernels SIMD '%s' indisponíveis nesta CPU, "
+                    "usando detecção automática\n", TSP_SIMD_FORCE);
+#endif
+
+    for (int i = count - 1; i >= 0; i--) {
+        if (simd_supported(simd_variants[i].name)) {
+            simd = simd_variants[i];
+            return;
+        }
+    }
+}
@@ -0,0 +1,242 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+/**
+ * Gerador de instâncias sintéticas (tsp_gen e benchmarks)
+ *
+ * Modelos de distância:
+ * - uniform: cidades uniformes em um quadrado, distância euclidiana
+ * - clustered: cidades em torno de centros de agrupamentos (normal)
+ * - asymmetric: como uniform, mas cada arco i -> j tem um acréscimo próprio
+ *   de até --asymmetry vezes a distância (e o risco também é assimétrico)
+ *
+ * Cada número da instância (coordenadas, riscos, tempos, acréscimos) é uma
+ * função apenas da semente e dos índices, não da ordem de geração: a mesma
+ * semente gera a mesma instância nos dois formatos e, com qualquer n, as
+ * primeiras cidades ficam nos mesmos lugares (no modelo clustered, desde
+ * que --clusters seja o mesmo). Distâncias e riscos são arredondados para
+ * centésimos, então o texto e o binário gerados são lidos como instâncias
+ * idênticas.
+ *
+ * O tempo total de qualquer rota é a soma dos tempos mínimos, pois todas as
+ * cidades são visitadas; o orçamento (poder de KingsLanding) é essa soma
+ * mais uma folga. Com folga 0 (tight) a rota cabe exatamente no orçamento;
+ * com folga negativa a instância é inviável.
+ *
+ * As linhas das matrizes são geradas e gravadas uma de cada vez (memória
+ * O(n)), o que permite gerar instâncias de dezenas de milhares de cidades.
+ */
+
+// Fluxos independentes de números aleatórios
+enum { STREAM_POINT, STREAM_CLUSTER, STREAM_CENTER, STREAM_ASYM, STREAM_RISK, STREAM_HOUSE };
+
+// Parâmetros e coordenadas das cidades da instância em geração
+typedef struct {
+    SynthParams p;
+    int clusters;           // Agrupamentos efetivos (clustered)
+    double* x;              // Coordenadas das cidades
+    double* y;
+} Generator;
+
+static const char* synth_model_names[] = { "uniform", "clustered", "asymmetric" };
+
+// Mistura de 64 bits (finalizador do splitmix64)
+static uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Número em [0, 1) determinado pela semente, pelo fluxo e pelos índices
+static double uniform(const Generator* g, int stream, uint64_t i, uint64_t j) {
+    uint64_t h = mix(g->p.seed ^ mix(((uint64_t)stream << 56) ^ mix(i ^ mix(j))));
+    return (h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Normal padrão (Box-Muller) determinada pelos índices
+static double normal(const Generator* g, int stream, uint64_t i, uint64_t j) {
+    double u1 = uniform(g, stream, i, 2 * j);
+    double u2 = uniform(g, stream, i, 2 * j + 1);
+    return sqrt(-2.0 * log(1.0 - u1)) * cos(2.0 * M_PI * u2);
+}
+
+// Arredonda para centésimos (valor exato do texto "%.2f" lido de volta)
+static double cents(double value) {
+    return llround(value * 100.0) / 100.0;
+}
+
+// Posiciona as cidades
+static void place_cities(Generator* g) {
+    for (int i = 0; i < g->p.n; i++) {
+        if (g->p.model == SYNTH_CLUSTERED) {
+            int c = (int)(uniform(g, STREAM_CLUSTER, i, 0) * g->clusters);
+            double cx = uniform(g, STREAM_CENTER, c, 0) * g->p.side;
+            double cy = uniform(g, STREAM_CENTER, c, 1) * g->p.side;
+            double sigma = g->p.side / (4.0 * sqrt((double)g->clusters));
+            g->x[i] = fmin(fmax(cx + sigma * normal(g, STREAM_POINT, i, 0), 0.0), g->p.side);
+            g->y[i] = fmin(fmax(cy + sigma * normal(g, STREAM_POINT, i, 1), 0.0), g->p.side);
+        } else {
+            g->x[i] = uniform(g, STREAM_POINT, i, 0) * g->p.side;
+            g->y[i] = uniform(g, STREAM_POINT, i, 1) * g->p.side;
+        }
+    }
+}
+
+// Linha i das matrizes de distância e risco (e do custo, se cost != NULL)
+static void generate_row(void* data, int i, double* cost, double* dist, double* risk) {
+    const Generator* g = (const Generator*)data;
+    int asymmetric = g->p.model == SYNTH_ASYMMETRIC;
+    for (int j = 0; j < g->p.n; j++) {
+        if (i == j) {
+            dist[j] = risk[j] = 0.0;
+        } else {
+            double d = hypot(g->x[i] - g->x[j], g->y[i] - g->y[j]);
+            if (asymmetric) {
+                d *= 1.0 + g->p.asymmetry * uniform(g, STREAM_ASYM, i, j);
+            }
+            // Cidades distintas nunca ficam à distância zero
+            dist[j] = fmax(cents(d), 0.01);
+            int a = asymmetric || i < j ? i : j;
+            int b = asymmetric || i < j ? j : i;
+            risk[j] = cents(g->p.risk_max * uniform(g, STREAM_RISK, a, b));
+        }
+        if (cost) {
+            cost[j] = dist[j] * (1.0 + risk[j]);
+        }
+    }
+}
+
+// Casas: tempos mínimos, poder e lealdade; o poder de KingsLanding é o orçamento
+static House* generate_houses(const Generator* g) {
+    House* houses = (House*)calloc(g->p.n, sizeof(House));
+    long long total_time = 0;
+    for (int i = 0; i < g->p.n; i++) {
+        if (i == 0) {
+            snprintf(houses[i].name, sizeof(houses[i].name), "KingsLanding");
+        } else {
+            snprintf(houses[i].name, sizeof(houses[i].name), "Casa%d", i);
+        }
+        houses[i].min_time = 1 + (int)(uniform(g, STREAM_HOUSE, i, 0) * g->p.max_min_time);
+        houses[i].power = 10 + (int)(uniform(g, STREAM_HOUSE, i, 1) * 90);
+        houses[i].loyalty = cents(uniform(g, STREAM_HOUSE, i, 2));
+        total_time += houses[i].min_time;
+    }
+    double budget = ceil(total_time * (1.0 + g->p.slack));
+    houses[0].power = budget > 2e9 ? 2000000000 : budget < 0 ? 0 : (int)budget;
+    return houses;
+}
+
+// Escreve um valor com duas casas decimais seguido de espaço (como "%.2f ")
+static char* put_value(char* p, double value) {
+    long long c = llround(value * 100.0);
+    char digits[24];
+    int len = 0;
+    long long whole = c / 100;
+    do {
+        digits[len++] = (char)('0' + whole % 10);
+        whole /= 10;
+    } while (whole > 0);
+    while (len > 0) {
+        *p++ = digits[--len];
+    }
+    *p++ = '.';
+    *p++ = (char)('0' + (c / 10) % 10);
+    *p++ = (char)('0' + c % 10);
+    *p++ = ' ';
+    return p;
+}
+
+// Grava a instância no formato texto, uma linha de matriz por vez
+static int write_text(const Generator* g, const House* houses, const char* filename) {
+    FILE* f = fopen(filename, "w");
+    if (!f) {
+        printf("Erro ao criar arquivo %s\n", filename);
+        return 0;
+    }
+    int n = g->p.n;
+    fprintf(f, "%d\n", n);
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s %d %.2f %d\n", houses[i].name, houses[i].power,
+                houses[i].loyalty, houses[i].min_time);
+    }
+
+    double* dist = (double*)malloc(2 * (size_t)n * sizeof(double));
+    double* risk = dist + n;
+    char* line = (char*)malloc((size_t)n * 24 + 2);
+    int ok = 1;
+    for (int block = 0; ok && block < 2; block++) {
+        for (int i = 0; ok && i < n; i++) {
+            generate_row((void*)g, i, NULL, dist, risk);
+            const double* row = block == 0 ? dist : risk;
+            char* p = line;
+            for (int j = 0; j < n; j++) {
+                p = put_value(p, row[j]);
+            }
+            *p++ = '\n';
+            ok = fwrite(line, 1, p - line, f) == (size_t)(p - line);
+        }
+    }
+    free(line);
+    free(dist);
+
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) {
+        printf("Erro ao gravar arquivo %s\n", filename);
+    }
+    return ok;
+}
+
+// Parâmetros padrão do tsp_gen para n cidades
+void synth_defaults(SynthParams* p, int n) {
+    memset(p, 0, sizeof(*p));
+    p->n = n;
+    p->model = SYNTH_UNIFORM;
+    p->seed = 1;
+    p->side = 1000.0;
+    p->clusters = 0;
+    p->asymmetry = 0.5;
+    p->risk_max = 0.5;
+    p->max_min_time = 10;
+    p->slack = 1.0;
+}
+
+const char* synth_model_name(SynthModel model) {
+    return synth_model_names[model];
+}
+
+int parse_synth_model(const char* name, SynthModel* model) {
+    for (int k = 0; k < 3; k++) {
+        if (strcmp(name, synth_model_names[k]) == 0) {
+            *model = (SynthModel)k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Gera a instância e a grava em filename (texto ou binário). Se budget não
+// for NULL, recebe o orçamento (poder de KingsLanding). Retorna 1 se gravou
+int synth_write(const SynthParams* p, const char* filename, int binary, int* budget) {
+    Generator g;
+    g.p = *p;
+    g.clusters = p->clusters > 0 ? p->clusters : (int)ceil(sqrt((double)p->n));
+    g.x = (double*)malloc(p->n * sizeof(double));
+    g.y = (double*)malloc(p->n * sizeof(double));
+    place_cities(&g);
+    House* houses = generate_houses(&g);
+
+    int ok = binary ? write_instance_bin_rows(filename, p->n, houses, generate_row, &g)
+                    : write_text(&g, houses, filename);
+    if (budget) {
+        *budget = houses[0].power;
+    }
+    free(houses);
+    free(g.x);
+    free(g.y);
+    return ok;
+}
@@ -0,0 +1,288 @@
+#include "tsp_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <pthread.h>
+#include <time.h>
+
+/**
+ * Telemetria das execuções
+ *
+ * Cada método cria um registro no início da solução e o preenche durante a
+ * busca: tempos de cada fase, a evolução da incumbente e do limite inferior
+ * (um ponto a cada melhoria e a cada registro de progresso) e os
+ * contadores da busca. No fim, telemetry_finish grava o registro em
+ * logs/<instância>_<método>.json, ao lado do log em texto, e acrescenta
+ * uma linha ao CSV de --telemetry-csv. Os scripts de análise leem esses
+ * arquivos em vez de interpretar o texto dos logs.
+ *
+ * Os pontos da evolução podem vir de várias threads (BB) e são protegidos
+ * por um mutex; são raros (melhorias e progresso), fora do caminho quente.
+ */
+
+#define TELEMETRY_MAX_PHASES 8
+
+typedef struct {
+    double time;            // Segundos desde o início do método
+    double incumbent;       // Melhor custo conhecido (DBL_MAX = nenhum)
+    double bound;           // Maior limite inferior conhecido (-DBL_MAX = nenhum)
+} TracePoint;
+
+typedef struct {
+    const char* name;
+    double seconds;
+} PhaseTime;
+
+struct Telemetry {
+    char instance[256];
+    Engine engine;
+    struct timespec start;
+    PhaseTime phases[TELEMETRY_MAX_PHASES];
+    int num_phases;
+    double phase_start;         // Início da última fase (aberta)
+    pthread_mutex_t lock;       // Protege o traço e os últimos valores
+    TracePoint* trace;
+    int trace_size;
+    int trace_capacity;
+    double incumbent;
+    double bound;
+    long long nodes_explored;   // -1 = não se aplica ao método
+    long long nodes_pruned;
+    long long peak_frontier;
+};
+
+// Rótulo do método nos nomes de arquivo e na linha "Método:" dos logs
+static const char* engine_tags[] = { "BB", "PLI", "DP", "LK" };
+
+// Protege o CSV compartilhado entre as instâncias do modo lote
+static pthread_mutex_t csv_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static double elapsed_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// Cria o registro de uma execução; o relógio das fases e do traço começa aqui
+Telemetry* telemetry_create(const char* instance, Engine engine) {
+    Telemetry* t = (Telemetry*)calloc(1, sizeof(Telemetry));
+    snprintf(t->instance, sizeof(t->instance), "%s", instance);
+    t->engine = engine;
+    clock_gettime(CLOCK_MONOTONIC, &t->start);
+    pthread_mutex_init(&t->lock, NULL);
+    t->incumbent = DBL_MAX;
+    t->bound = -DBL_MAX;
+    t->nodes_explored = -1;
+    t->nodes_pruned = -1;
+    t->peak_frontier = -1;
+    return t;
+}
+
+// Segundos desde a criação do registro
+double telemetry_elapsed(const Telemetry* t) {
+    return elapsed_since(&t->start);
+}
+
+// Encerra a fase atual e inicia a fase name (NULL apenas encerra)
+void telemetry_phase(Telemetry* t, const char* name) {
+    double now = elapsed_since(&t->start);
+    if (t->num_phases > 0 && t->phases[t->num_phases - 1].seconds < 0) {
+        t->phases[t->num_phases - 1].seconds = now - t->phase_start;
+    }
+    if (name && t->num_phases < TELEMETRY_MAX_PHASES) {
+        t->phases[t->num_phases].name = name;
+        t->phases[t->num_phases].seconds = -1.0;
+        t->num_phases++;
+        t->phase_start = now;
+    }
+}
+
+// Acrescenta um ponto ao traço. incumbent = DBL_MAX ou bound = -DBL_MAX
+// mantêm o último valor conhecido
+void telemetry_point(Telemetry* t, double incumbent, double bound) {
+    double now = elapsed_since(&t->start);
+    pthread_mutex_lock(&t->lock);
+    if (incumbent < t->incumbent) t->incumbent = incumbent;
+    if (bound > t->bound) t->bound = bound;
+    if (t->trace_size == t->trace_capacity) {
+        int capacity = t->trace_capacity ? 2 * t->trace_capacity : 64;
+        TracePoint* trace = (TracePoint*)realloc(t->trace, capacity * sizeof(TracePoint));
+        if (!trace) {
+            pthread_mutex_unlock(&t->lock);
+            return;
+        }
+        t->trace = trace;
+        t->trace_capacity = capacity;
+    }
+    TracePoint* p = &t->trace[t->trace_size++];
+    p->time = now;
+    p->incumbent = t->incumbent;
+    p->bound = t->bound;
+    pthread_mutex_unlock(&t->lock);
+}
+
+// Contadores da busca (-1 = não se aplica)
+void telemetry_counters(Telemetry* t, long long nodes_explored, long long nodes_pruned,
+                        long long peak_frontier) {
+    t->nodes_explored = nodes_explored;
+    t->nodes_pruned = nodes_pruned;
+    t->peak_frontier = peak_frontier;
+}
+
+// Número em JSON: valores sem sentido (sem solução, sem limite) viram null
+static void json_number(FILE* f, double value) {
+    if (value >= DBL_MAX || value <= -DBL_MAX || value != value) {
+        fprintf(f, "null");
+    } else {
+        fprintf(f, "%.10g", value);
+    }
+}
+
+static void json_count(FILE* f, long long value) {
+    if (value < 0) {
+        fprintf(f, "null");
+    } else {
+        fprintf(f, "%lld", value);
+    }
+}
+
+// Texto em JSON (nomes de instância vêm de nomes de arquivo)
+static void json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', f);
+            fputc(*s, f);
+        } else if ((unsigned char)*s < 0x20) {
+            fprintf(f, "\\u%04x", *s);
+        } else {
+            fputc(*s, f);
+        }
+    }
+    fputc('"', f);
+}
+
+// Threads usadas pelo método (o PLI e a LK usam uma só)
+static int engine_threads(Engine engine) {
+    return engine == ENGINE_BB || engine == ENGINE_DP ? config.threads : 1;
+}
+
+static const char* solution_status(const Solution* sol) {
+    if (!sol->feasible) return "no_solution";
+    return sol->optimal ? "optimal" : "feasible";
+}
+
+static void write_json(const Telemetry* t, const Solution* sol, long rss_kb) {
+    char filename[512];
+    snprintf(filename, sizeof(filename), "logs/%s_%s.json", t->instance, engine_tags[t->engine]);
+    FILE* f = fopen(filename, "w");
+    if (!f) {
+        fprintf(stderr, "Erro ao criar arquivo de telemetria: %s\n", filename);
+        return;
+    }
+    double nodes_per_second = t->nodes_explored >= 0 && sol->time > 0 ?
+                              t->nodes_explored / sol->time : -1.0;
+
+    fprintf(f, "{\n  \"instance\": ");
+    json_string(f, t->instance);
+    fprintf(f, ",\n  \"engine\": \"%s\",\n  \"method\": \"%s\",\n",
+            engine_name(t->engine), engine_tags[t->engine]);
+    fprintf(f, "  \"status\": \"%s\",\n", solution_status(sol));
+    fprintf(f, "  \"feasible\": %s,\n  \"optimal\": %s,\n",
+            sol->feasible ? "true" : "false", sol->optimal ? "true" : "false");
+    fprintf(f, "  \"cost\": ");
+    json_number(f, sol->feasible ? sol->cost : DBL_MAX);
+    fprintf(f, ",\n  \"lower_bound\": ");
+    json_number(f, t->bound);
+    fprintf(f, ",\n  \"gap\": ");
+    json_number(f, sol->gap);
+    fprintf(f, ",\n  \"time\": ");
+    json_number(f, sol->time);
+    fprintf(f, ",\n  \"threads\": %d,\n", engine_threads(t->engine));
+    fprintf(f, "  \"nodes_explored\": ");
+    json_count(f, t->nodes_explored);
+    fprintf(f, ",\n  \"nodes_pruned\": ");
+    json_count(f, t->nodes_pruned);
+    fprintf(f, ",\n  \"nodes_per_second\": ");
+    json_number(f, nodes_per_second < 0 ? DBL_MAX : nodes_per_second);
+    fprintf(f, ",\n  \"peak_frontier\": ");
+    json_count(f, t->peak_frontier);
+    fprintf(f, ",\n  \"peak_rss_kb\": ");
+    json_count(f, rss_kb);
+
+    fprintf(f, ",\n  \"phases\": [");
+    for (int i = 0; i < t->num_phases; i++) {
+        fprintf(f, "%s\n    {\"name\": \"%s\", \"seconds\": ", i ? "," : "", t->phases[i].name);
+        json_number(f, t->phases[i].seconds);
+        fprintf(f, "}");
+    }
+    fprintf(f, "%s],\n  \"trace\": [", t->num_phases ? "\n  " : "");
+    for (int i = 0; i < t->trace_size; i++) {
+        const TracePoint* p = &t->trace[i];
+        fprintf(f, "%s\n    {\"time\": ", i ? "," : "");
+        json_number(f, p->time);
+        fprintf(f, ", \"incumbent\": ");
+        json_number(f, p->incumbent);
+        fprintf(f, ", \"bound\": ");
+        json_number(f, p->bound);
+        fprintf(f, "}");
+    }
+    fprintf(f, "%s]\n}\n", t->trace_size ? "\n  " : "");
+    fclose(f);
+}
+
+// Uma linha por execução no CSV de --telemetry-csv (cabeçalho se vazio)
+static void append_csv(const Telemetry* t, const Solution* sol, long rss_kb) {
+    pthread_mutex_lock(&csv_lock);
+    FILE* f = fopen(config.telemetry_csv, "a");
+    if (!f) {
+        fprintf(stderr, "Erro ao abrir arquivo de telemetria: %s\n", config.telemetry_csv);
+        pthread_mutex_unlock(&csv_lock);
+        return;
+    }
+    if (ftell(f) == 0) {
+        fprintf(f, "instance,engine,method,status,cost,lower_bound,gap,time,threads,"
+                   "nodes_explored,nodes_pruned,nodes_per_second,peak_frontier,peak_rss_kb\n");
+    }
+    char lower_bound[32] = "";
+    if (t->bound > -DBL_MAX) {
+        snprintf(lower_bound, sizeof(lower_bound), "%.10g", t->bound);
+    }
+    char cost[32] = "";
+    if (sol->feasible) {
+        snprintf(cost, sizeof(cost), "%.10g", sol->cost);
+    }
+    char nodes[3][32] = { "", "", "" };
+    char rate[32] = "";
+    if (t->nodes_explored >= 0) {
+        snprintf(nodes[0], sizeof(nodes[0]), "%lld", t->nodes_explored);
+        if (sol->time > 0) snprintf(rate, sizeof(rate), "%.0f", t->nodes_explored / sol->time);
+    }
+    if (t->nodes_pruned >= 0) snprintf(nodes[1], sizeof(nodes[1]), "%lld", t->nodes_pruned);
+    if (t->peak_frontier >= 0) snprintf(nodes[2], sizeof(nodes[2]), "%lld", t->peak_frontier);
+    fprintf(f, "%s,%s,%s,%s,%s,%s,%.10g,%.10g,%d,%s,%s,%s,%s,%ld\n", t->instance,
+            engine_name(t->engine), engine_tags[t->engine], solution_status(sol), cost,
+            lower_bound, sol->gap, sol->time, engine_threads(t->engine),
+            nodes[0], nodes[1], rate, nodes[2], rss_kb);
+    fclose(f);
+    pthread_mutex_unlock(&csv_lock);
+}
+
+// Encerra a última fase, grava o registro da execução e o libera
+void telemetry_finish(Telemetry* t, const Solution* sol) {
+    telemetry_phase(t, NULL);
+    // O gap final já traduz o melhor limite do método
+    if (sol->feasible) {
+        telemetry_point(t, sol->cost, sol->gap < 100.0 ? sol->cost * (1.0 - sol->gap / 100.0) :
+                                                         -DBL_MAX);
+    }
+    long rss_kb = peak_rss_kb();
+    write_json(t, sol, rss_kb);
+    if (config.telemetry_csv) {
+        append_csv(t, sol, rss_kb);
+    }
+    pthread_mutex_destroy(&t->lock);
+    free(t->trace);
+    free(t);
+}